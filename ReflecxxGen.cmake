@@ -29,7 +29,12 @@ if (NOT DEFINED REFLECXX_LIBCLANG_DIR)
   endif()
 endif()
 
+# ${REFLECXX_PREFIX_HEADER} can be set to a header that includes what most of the input files include, e.g. standard
+# library or third party headers. It is precompiled once and reused for parsing every input, rather than each parse
+# processing those headers again.
+
 set(PROTOGEN_SOURCES
+  ${CMAKE_CURRENT_LIST_DIR}/generator/layout_report.py
   ${CMAKE_CURRENT_LIST_DIR}/generator/parse.py
   ${CMAKE_CURRENT_LIST_DIR}/generator/parse_types.py
   ${CMAKE_CURRENT_LIST_DIR}/generator/visitor_generator.py
@@ -74,38 +79,102 @@ macro(get_compilation_flags TARGET FLAGS_OUT)
   set(${FLAGS_OUT} "${ALL_FLAGS}")
 endmacro()
 
-# Generate Reflecxx headers based on the provided input files, using compilation flags from the provided target. Adds a
-# depencency on the generated headers to the target.
-macro(reflecxx_generate INPUT_FILES TARGET)
-  set(OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/generated_headers)
-  # Since the generated output file names will be determined based on the input, we will use a trick to ensure cmake
-  # doesn't run the custom_command on every build if it doesn't have to. We'll just touch an indicator file.
-  # This wouldn't be necessary if cmake could track directories at outputs but it doesn't seem to be able to.
-  set(OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/generated_headers/generated.txt)
+# Build systems that can read the depfiles written by the generator, so that changes to anything an input header
+# includes cause it to be regenerated.
+set(REFLECXX_USE_DEPFILE OFF)
+if (CMAKE_GENERATOR MATCHES "Ninja" OR (CMAKE_GENERATOR MATCHES "Makefiles" AND NOT CMAKE_VERSION VERSION_LESS 3.20))
+  set(REFLECXX_USE_DEPFILE ON)
+endif()
+if (POLICY CMP0116)
+  # Depfile paths are made relative to the build directory for Ninja, as it expects.
+  cmake_policy(SET CMP0116 NEW)
+endif()
 
-  get_compilation_flags(${TARGET} FLAGS)
+# Adds the command generating the Reflecxx headers of INPUT_FILES into OUTPUT_DIR, and appends the headers to OUTPUTS in
+# the calling scope. Any further arguments are passed on to the generator.
+function(reflecxx_add_generate_command INPUT_FILES FLAGS OUTPUT_DIR)
+  set(COMMAND_OUTPUTS)
+  foreach(INPUT_FILE ${INPUT_FILES})
+    get_filename_component(INPUT_NAME ${INPUT_FILE} NAME)
+    list(APPEND COMMAND_OUTPUTS ${OUTPUT_DIR}/${INPUT_NAME}.reflecxx_generated.hpp)
+  endforeach()
+  list(GET COMMAND_OUTPUTS 0 FIRST_OUTPUT)
+
+  if (REFLECXX_USE_DEPFILE)
+    # With several outputs, each depends on the same files, so the depfile of the first covers them all.
+    set(DEPFILE_ARGS DEPFILE ${FIRST_OUTPUT}.d)
+  elseif (CMAKE_GENERATOR MATCHES "Makefiles")
+    # Older CMake can't use depfiles with Makefiles, but can scan the includes itself.
+    set(DEPFILE_ARGS)
+    foreach(INPUT_FILE ${INPUT_FILES})
+      list(APPEND DEPFILE_ARGS IMPLICIT_DEPENDS CXX ${CMAKE_CURRENT_SOURCE_DIR}/${INPUT_FILE})
+    endforeach()
+  else()
+    set(DEPFILE_ARGS)
+  endif()
+
+  if (DEFINED REFLECXX_PREFIX_HEADER)
+    list(APPEND DEPFILE_ARGS DEPENDS ${REFLECXX_PREFIX_HEADER})
+    set(PREFIX_HEADER_ARGS --prefix-header ${REFLECXX_PREFIX_HEADER})
+  else()
+    set(PREFIX_HEADER_ARGS)
+  endif()
+
+  list(LENGTH COMMAND_OUTPUTS OUTPUT_COUNT)
+  if (OUTPUT_COUNT EQUAL 1)
+    get_filename_component(COMMENT_NAME ${INPUT_FILES} NAME)
+  else()
+    set(COMMENT_NAME "${OUTPUT_COUNT} inputs")
+  endif()
 
   add_custom_command(
-    OUTPUT ${OUTPUT}
+    OUTPUT ${COMMAND_OUTPUTS}
     COMMAND ${REFLECXX_PYTHON_CMD} ${REFLECXX_GEN_BASE_DIR}/generator/parse.py
     --libclang-directory ${REFLECXX_LIBCLANG_DIR}
     --input-files ${INPUT_FILES}
     --output-folder ${OUTPUT_DIR}
     --flags="${FLAGS}"
-    COMMAND ${CMAKE_COMMAND} -E touch ${OUTPUT}
+    # The build system tracks what needs regenerating, and runs the commands in parallel.
+    --no-cache
+    --depfiles
+    ${PREFIX_HEADER_ARGS}
+    ${ARGN}
+    ${DEPFILE_ARGS}
     # so that source files can be provided with relative paths
     WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
-    COMMENT "Running ReflecxxGen. Generating into: ${OUTPUT_DIR}"
+    COMMENT "Running ReflecxxGen on ${COMMENT_NAME}. Generating into: ${OUTPUT_DIR}"
     DEPENDS ${INPUT_FILES} ${PROTOGEN_SOURCES}
     # Surprisingly, not using USES_TERMINAL gives better output because error messages show up at the end of the
     # output when generation fails.
     #USES_TERMINAL
     #VERBATIM
   )
-  # Have targets depend on the indicator file.
+  set(OUTPUTS ${OUTPUTS} ${COMMAND_OUTPUTS} PARENT_SCOPE)
+endfunction()
+
+# Generate Reflecxx headers based on the provided input files, using compilation flags from the provided target. Adds a
+# depencency on the generated headers to the target.
+# If ${REFLECXX_COMBINED} is set, a single command generates every header, parsing the input files as one translation
+# unit (`--combined` for the generator) so that the includes they share are only parsed once. The input files must then
+# be able to be included together, and editing any of them regenerates all of them.
+macro(reflecxx_generate INPUT_FILES TARGET)
+  set(OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/generated_headers)
+
+  get_compilation_flags(${TARGET} FLAGS)
+
+  set(OUTPUTS)
+  if (REFLECXX_COMBINED)
+    reflecxx_add_generate_command("${INPUT_FILES}" "${FLAGS}" ${OUTPUT_DIR} --combined)
+  else()
+    # One command per input, so that editing a header only regenerates that header.
+    foreach(INPUT_FILE ${INPUT_FILES})
+      reflecxx_add_generate_command(${INPUT_FILE} "${FLAGS}" ${OUTPUT_DIR})
+    endforeach()
+  endif()
+  # Have targets depend on the generated headers.
   add_custom_target(${TARGET}_REFLECXX_GEN
     DEPENDS
-      ${OUTPUT_DIR}/generated.txt
+      ${OUTPUTS}
   )
   # Make sure running a clean removes the generated files
   set_target_properties(${TARGET} PROPERTIES ADDITIONAL_CLEAN_FILES ${OUTPUT_DIR})
@@ -121,3 +190,29 @@ macro(reflecxx_generate INPUT_FILES TARGET)
     ${CMAKE_CURRENT_BINARY_DIR} # to find the generated headers
 )
 endmacro()
+
+# Add a ${TARGET}_layout_report target, not built by default, that writes a report of the memory layout of the types
+# annotated in the provided input files to ${TARGET}_layout_report.json and prints a summary, using compilation flags
+# from the provided target.
+macro(reflecxx_layout_report INPUT_FILES TARGET)
+  get_compilation_flags(${TARGET} FLAGS)
+  set(REPORT ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_layout_report.json)
+
+  if (DEFINED REFLECXX_PREFIX_HEADER)
+    set(PREFIX_HEADER_ARGS --prefix-header ${REFLECXX_PREFIX_HEADER})
+  else()
+    set(PREFIX_HEADER_ARGS)
+  endif()
+
+  add_custom_target(${TARGET}_layout_report
+    COMMAND ${REFLECXX_PYTHON_CMD} ${REFLECXX_GEN_BASE_DIR}/generator/parse.py
+    --libclang-directory ${REFLECXX_LIBCLANG_DIR}
+    --input-files ${INPUT_FILES}
+    --flags="${FLAGS}"
+    --layout-report ${REPORT}
+    ${PREFIX_HEADER_ARGS}
+    WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
+    COMMENT "Running ReflecxxGen layout report. Writing: ${REPORT}"
+    DEPENDS ${INPUT_FILES} ${PROTOGEN_SOURCES}
+  )
+endmacro()
@@ -0,0 +1,83 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include <reflecxx/attributes.hpp>
+#include <reflecxx/struct_visitor.hpp>
+
+// Synthetic reflected types for the runtime benchmarks, of growing field count, nesting depth and enum size.
+// The fields and enumerators are listed in X-macros, as X(type, name) and X(name), so that the hand-written baselines
+// can be expanded from the same lists as the types.
+
+#define BENCH_FIELDS_4(X, P) X(int32_t, P##a) X(double, P##b) X(float, P##c) X(int64_t, P##d)
+#define BENCH_FIELDS_16(X, P) \
+    BENCH_FIELDS_4(X, P##a) BENCH_FIELDS_4(X, P##b) BENCH_FIELDS_4(X, P##c) BENCH_FIELDS_4(X, P##d)
+#define BENCH_FIELDS_64(X, P) \
+    BENCH_FIELDS_16(X, P##a) BENCH_FIELDS_16(X, P##b) BENCH_FIELDS_16(X, P##c) BENCH_FIELDS_16(X, P##d)
+
+#define BENCH_ENUMERATORS_4(X, P) X(P##A) X(P##B) X(P##C) X(P##D)
+#define BENCH_ENUMERATORS_16(X, P) \
+    BENCH_ENUMERATORS_4(X, P##A) BENCH_ENUMERATORS_4(X, P##B) BENCH_ENUMERATORS_4(X, P##C) BENCH_ENUMERATORS_4(X, P##D)
+#define BENCH_ENUMERATORS_64(X, P)                              \
+    BENCH_ENUMERATORS_16(X, P##A) BENCH_ENUMERATORS_16(X, P##B) \
+    BENCH_ENUMERATORS_16(X, P##C) BENCH_ENUMERATORS_16(X, P##D)
+
+#define BENCH_DECLARE_FIELD(type, name) type name{};
+#define BENCH_DECLARE_ENUMERATOR(name) name,
+
+namespace bench {
+
+struct Fields4 {
+    BENCH_FIELDS_4(BENCH_DECLARE_FIELD, f)
+
+    bool operator==(const Fields4& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+struct Fields16 {
+    BENCH_FIELDS_16(BENCH_DECLARE_FIELD, f)
+
+    bool operator==(const Fields16& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+struct Fields64 {
+    BENCH_FIELDS_64(BENCH_DECLARE_FIELD, f)
+
+    bool operator==(const Fields64& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+// Each level wraps the one below it, down to a Fields4.
+struct Depth1 {
+    int32_t level{};
+    Fields4 inner;
+
+    bool operator==(const Depth1& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+struct Depth2 {
+    int32_t level{};
+    Depth1 inner;
+
+    bool operator==(const Depth2& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+struct Depth3 {
+    int32_t level{};
+    Depth2 inner;
+
+    bool operator==(const Depth3& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+struct Depth4 {
+    int32_t level{};
+    Depth3 inner;
+
+    bool operator==(const Depth4& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+enum class Enum4 { BENCH_ENUMERATORS_4(BENCH_DECLARE_ENUMERATOR, E) } REFLECXX_T;
+enum class Enum16 { BENCH_ENUMERATORS_16(BENCH_DECLARE_ENUMERATOR, E) } REFLECXX_T;
+enum class Enum64 { BENCH_ENUMERATORS_64(BENCH_DECLARE_ENUMERATOR, E) } REFLECXX_T;
+
+} // namespace bench
+
+#include REFLECXX_HEADER(bench_types.hpp)
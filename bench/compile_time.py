@@ -0,0 +1,122 @@
+# Copyright (c) 2021-2022 Jimmy O'Rourke
+# Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+# Official repository: https://github.com/jimmyorourke/reflecxx
+
+import argparse
+import subprocess
+import time
+
+from os import PathLike
+from pathlib import Path
+from typing import List
+
+# Measures how the compile time of a translation unit using the reflecxx visitors scales with the number of fields in
+# the reflected types. For each field count, a source file is written with a derived struct and its base class sharing
+# the fields between them, along with the MetaStructInternal specializations the generator would produce for them, so
+# libclang isn't needed. The source exercises instance, type and accumulating visitation, comparison and indexed access.
+
+FIELD_TYPES = ["int", "double", "char", "float", "long"]
+
+
+def meta_struct(name: str, fields: List[str], bases: List[str]) -> str:
+    """Returns the MetaStructInternal specialization for a struct, in the form of the generated code."""
+    members = ",\n".join(
+        f"        ClassMember<Type, {FIELD_TYPES[i % len(FIELD_TYPES)]}>{{&Type::{f}, \"{f}\"}}"
+        for i, f in enumerate(fields)
+    )
+    base_tags = ",\n".join(f"        type_tag<{b}>{{}}" for b in bases)
+    return f"""
+template <>
+struct MetaStructInternal<{name}> {{
+    using Type = {name};
+    static constexpr std::string_view name{{"{name}"}};
+    static constexpr auto publicFields = std::make_tuple(
+{members}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+{base_tags}
+    );
+}};
+"""
+
+
+def make_source(field_count: int) -> str:
+    """Returns a translation unit using reflected types with field_count fields in total."""
+    base_fields = [f"base{i}" for i in range(field_count // 2)]
+    fields = [f"field{i}" for i in range(field_count - len(base_fields))]
+
+    def declare(names: List[str], offset: int) -> str:
+        return "\n".join(f"    {FIELD_TYPES[(i + offset) % len(FIELD_TYPES)]} {n}{{}};" for i, n in enumerate(names))
+
+    return f"""#include <reflecxx/types.hpp>
+
+#include <string_view>
+#include <tuple>
+
+struct Base {{
+{declare(base_fields, 0)}
+}};
+struct Derived : Base {{
+{declare(fields, 0)}
+}};
+
+namespace reflecxx::detail {{
+{meta_struct("Base", base_fields, [])}
+{meta_struct("Derived", fields, ["Base"])}
+}} // namespace reflecxx::detail
+
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+struct Counter {{
+    template <typename T>
+    void operator()(std::string_view, const T&) {{ ++count; }}
+    int count{{}};
+}};
+
+int run() {{
+    Derived d1{{}};
+    Derived d2{{}};
+    Counter counter;
+    reflecxx::visit(d1, counter);
+    reflecxx::visit<Derived>(counter);
+    const auto sizes = reflecxx::visitAccummulate(d1, [](std::string_view, const auto& v) {{ return sizeof(v); }});
+    const auto names = reflecxx::visitAccummulate<Derived>([](std::string_view name, auto) {{ return name; }});
+    return counter.count + static_cast<int>(std::get<0>(sizes)) + static_cast<int>(std::get<0>(names).size()) +
+           reflecxx::equalTo(d1, d2) + static_cast<int>(reflecxx::get<reflecxx::fieldCount<Derived>() - 1>(d1));
+}}
+"""
+
+
+def main(compiler: str, include_dir: PathLike, work_dir: PathLike, field_counts: List[int], flags: List[str], repeat: int):
+    Path(work_dir).mkdir(parents=True, exist_ok=True)
+    print(f"{'fields':>8} {'seconds':>10}")
+    for count in field_counts:
+        source = Path(work_dir) / f"fields_{count}.cpp"
+        source.write_text(make_source(count))
+        command = [compiler, "-std=c++17", f"-I{include_dir}", *flags, "-c", str(source), "-o", str(source) + ".o"]
+        best = None
+        for _ in range(repeat):
+            start = time.perf_counter()
+            subprocess.run(command, check=True)
+            elapsed = time.perf_counter() - start
+            best = elapsed if best is None else min(best, elapsed)
+        print(f"{count:>8} {best:>10.2f}")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--compiler", default="c++", help="C++ compiler to benchmark")
+    parser.add_argument("--include-dir", required=True, help="reflecxx include directory")
+    parser.add_argument("--work-dir", default="compile_time", help="Folder for generated sources and objects")
+    parser.add_argument(
+        "--field-counts", type=int, nargs="*", default=[10, 25, 50, 100, 200], help="Total field counts to measure"
+    )
+    parser.add_argument("--repeat", type=int, default=3, help="Compilations per field count, the fastest is reported")
+    # Use a single string rather than a list to be able to support the leading dashes on the flags
+    parser.add_argument(
+        "--flags", type=str, default="", help="Additional compiler flags, space separated. Needs to be specified as --flags="
+    )
+    args = parser.parse_args()
+
+    main(args.compiler, args.include_dir, args.work_dir, args.field_counts, args.flags.split(), args.repeat)
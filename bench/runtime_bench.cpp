@@ -0,0 +1,403 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include <reflecxx/enum_visitor.hpp>
+#include <reflecxx/json_reader.hpp>
+#include <reflecxx/json_writer.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include "bench_types.hpp"
+
+// Runtime cost of the reflecxx visitors, enum lookups and JSON serialization, each measured against a hand-written
+// equivalent of the same work. The ...Reflecxx and ...Baseline benchmarks for a type should report the same time,
+// apart from where reflecxx uses a different algorithm, e.g. a perfect hash rather than comparing names one by one, or
+// does more, e.g. the JSON reader accepting keys in any order and whitespace, which the baseline reader doesn't.
+
+using namespace bench;
+
+namespace baseline {
+
+#define BENCH_SUM(type, name) sum += static_cast<double>(obj.name);
+#define BENCH_EQUAL(type, name) && lhs.name == rhs.name
+#define BENCH_WRITE(type, name) \
+    out += separator;           \
+    separator = ',';            \
+    out += "\"" #name "\":";    \
+    writeNumber(obj.name, out);
+#define BENCH_READ(type, name)   \
+    in.separator();              \
+    in.expect("\"" #name "\":"); \
+    in.number(obj.name);
+#define BENCH_NAME_CASE(name) \
+    case Enum::name:          \
+        return #name;
+#define BENCH_FROM_NAME(name) \
+    if (str == #name) {       \
+        return Enum::name;    \
+    }
+
+template <typename T>
+void writeNumber(T value, std::string& out) {
+    char buffer[64];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// Reads JSON written by the baseline writers, which is expected to have the keys in order and no whitespace.
+struct Reader {
+    void expect(std::string_view str) {
+        if (std::string_view{pos, static_cast<size_t>(end - pos)}.substr(0, str.size()) != str) {
+            throw std::runtime_error{"unexpected JSON"};
+        }
+        pos += str.size();
+    }
+    // The opening brace before the first field or the comma before any other.
+    void separator() {
+        if (pos == end || (*pos != '{' && *pos != ',')) {
+            throw std::runtime_error{"unexpected JSON"};
+        }
+        ++pos;
+    }
+    template <typename T>
+    void number(T& value) {
+        const auto result = std::from_chars(pos, end, value);
+        if (result.ec != std::errc{}) {
+            throw std::runtime_error{"invalid number"};
+        }
+        pos = result.ptr;
+    }
+
+    const char* pos;
+    const char* end;
+};
+
+#define BENCH_FLAT_BASELINES(Type, FIELDS)          \
+    double sum(const Type& obj) {                   \
+        double sum = 0;                             \
+        FIELDS(BENCH_SUM, f)                        \
+        return sum;                                 \
+    }                                               \
+    bool equal(const Type& lhs, const Type& rhs) {  \
+        return true FIELDS(BENCH_EQUAL, f);         \
+    }                                               \
+    void write(const Type& obj, std::string& out) { \
+        char separator = '{';                       \
+        FIELDS(BENCH_WRITE, f)                      \
+        out += '}';                                 \
+    }                                               \
+    void read(Reader& in, Type& obj) {              \
+        FIELDS(BENCH_READ, f)                       \
+        in.expect("}");                             \
+    }
+
+BENCH_FLAT_BASELINES(Fields4, BENCH_FIELDS_4)
+BENCH_FLAT_BASELINES(Fields16, BENCH_FIELDS_16)
+BENCH_FLAT_BASELINES(Fields64, BENCH_FIELDS_64)
+
+#define BENCH_NESTED_BASELINES(Type)                                  \
+    bool equal(const Type& lhs, const Type& rhs) {                    \
+        return lhs.level == rhs.level && equal(lhs.inner, rhs.inner); \
+    }                                                                 \
+    void write(const Type& obj, std::string& out) {                   \
+        out += "{\"level\":";                                         \
+        writeNumber(obj.level, out);                                  \
+        out += ",\"inner\":";                                         \
+        write(obj.inner, out);                                        \
+        out += '}';                                                   \
+    }                                                                 \
+    void read(Reader& in, Type& obj) {                                \
+        in.expect("{\"level\":");                                     \
+        in.number(obj.level);                                         \
+        in.expect(",\"inner\":");                                     \
+        read(in, obj.inner);                                          \
+        in.expect("}");                                               \
+    }
+
+BENCH_NESTED_BASELINES(Depth1)
+BENCH_NESTED_BASELINES(Depth2)
+BENCH_NESTED_BASELINES(Depth3)
+BENCH_NESTED_BASELINES(Depth4)
+
+template <typename T>
+void read(std::string_view json, T& obj) {
+    Reader in{json.data(), json.data() + json.size()};
+    read(in, obj);
+}
+
+// The last field, as reached through reflecxx::get<fieldCount<T>() - 1>.
+const int64_t& last(const Fields4& obj) { return obj.fd; }
+const int64_t& last(const Fields16& obj) { return obj.fdd; }
+const int64_t& last(const Fields64& obj) { return obj.fddd; }
+
+template <typename E>
+E fromName(std::string_view str);
+
+#define BENCH_ENUM_BASELINES(Type, ENUMERATORS)              \
+    std::string_view enumName(Type e) {                      \
+        using Enum = Type;                                   \
+        switch (e) {                                         \
+            ENUMERATORS(BENCH_NAME_CASE, E)                  \
+        }                                                    \
+        throw std::runtime_error{"invalid enumerator"};      \
+    }                                                        \
+    template <>                                              \
+    Type fromName<Type>(std::string_view str) {              \
+        using Enum = Type;                                   \
+        ENUMERATORS(BENCH_FROM_NAME, E)                      \
+        throw std::runtime_error{"invalid enumerator name"}; \
+    }
+
+BENCH_ENUM_BASELINES(Enum4, BENCH_ENUMERATORS_4)
+BENCH_ENUM_BASELINES(Enum16, BENCH_ENUMERATORS_16)
+BENCH_ENUM_BASELINES(Enum64, BENCH_ENUMERATORS_64)
+
+} // namespace baseline
+
+namespace {
+
+// Sets every arithmetic field of obj, recursively, to a different value.
+template <typename T>
+void fill(T& obj, int& next) {
+    reflecxx::visit(obj, [&next](std::string_view, auto& field) {
+        using F = std::decay_t<decltype(field)>;
+        if constexpr (std::is_arithmetic_v<F>) {
+            field = static_cast<F>(next++ * 1.25);
+        } else {
+            fill(field, next);
+        }
+    });
+}
+
+template <typename T>
+T makeValue() {
+    T obj{};
+    int next = 1;
+    fill(obj, next);
+    return obj;
+}
+
+template <typename T>
+void visitReflecxx(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        double sum = 0;
+        reflecxx::visit(obj, [&sum](std::string_view, const auto& field) { sum += static_cast<double>(field); });
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template <typename T>
+void visitBaseline(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(baseline::sum(obj));
+    }
+}
+
+template <typename T>
+void getReflecxx(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(reflecxx::get<reflecxx::fieldCount<T>() - 1>(obj));
+    }
+}
+
+template <typename T>
+void getBaseline(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(obj);
+        benchmark::DoNotOptimize(baseline::last(obj));
+    }
+}
+
+// Equal objects, so that every field is compared.
+template <typename T>
+void compareReflecxx(benchmark::State& state) {
+    const auto lhs = makeValue<T>();
+    const auto rhs = lhs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs);
+        benchmark::DoNotOptimize(rhs);
+        benchmark::DoNotOptimize(reflecxx::equalTo(lhs, rhs));
+    }
+}
+
+template <typename T>
+void compareBaseline(benchmark::State& state) {
+    const auto lhs = makeValue<T>();
+    const auto rhs = lhs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs);
+        benchmark::DoNotOptimize(rhs);
+        benchmark::DoNotOptimize(baseline::equal(lhs, rhs));
+    }
+}
+
+// Cycles through every enumerator.
+template <typename E>
+void enumNameReflecxx(benchmark::State& state) {
+    constexpr auto values = reflecxx::enumerators<E>();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reflecxx::enumName(values[i]));
+        i = i + 1 == values.size() ? 0 : i + 1;
+    }
+}
+
+template <typename E>
+void enumNameBaseline(benchmark::State& state) {
+    constexpr auto values = reflecxx::enumerators<E>();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(baseline::enumName(values[i]));
+        i = i + 1 == values.size() ? 0 : i + 1;
+    }
+}
+
+template <typename E>
+void fromNameReflecxx(benchmark::State& state) {
+    constexpr auto names = reflecxx::enumNames<E>();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reflecxx::fromName<E>(names[i]));
+        i = i + 1 == names.size() ? 0 : i + 1;
+    }
+}
+
+template <typename E>
+void fromNameBaseline(benchmark::State& state) {
+    constexpr auto names = reflecxx::enumNames<E>();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(baseline::fromName<E>(names[i]));
+        i = i + 1 == names.size() ? 0 : i + 1;
+    }
+}
+
+// Skips the benchmark unless reflecxx and the baseline write the same JSON, so that they're doing the same work.
+template <typename T>
+bool checkJson(benchmark::State& state, const T& obj) {
+    std::string json;
+    baseline::write(obj, json);
+    if (json != reflecxx::toJsonString(obj)) {
+        state.SkipWithError("baseline JSON differs from reflecxx JSON");
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+void toJsonReflecxx(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    if (!checkJson(state, obj)) {
+        return;
+    }
+    std::string json;
+    for (auto _ : state) {
+        json.clear();
+        reflecxx::writeJson(obj, std::back_inserter(json));
+        benchmark::DoNotOptimize(json.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+template <typename T>
+void toJsonBaseline(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    if (!checkJson(state, obj)) {
+        return;
+    }
+    std::string json;
+    for (auto _ : state) {
+        json.clear();
+        baseline::write(obj, json);
+        benchmark::DoNotOptimize(json.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+template <typename T>
+void fromJsonReflecxx(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    if (!checkJson(state, obj)) {
+        return;
+    }
+    const auto json = reflecxx::toJsonString(obj);
+    T result{};
+    for (auto _ : state) {
+        reflecxx::readJson(json, result);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+template <typename T>
+void fromJsonBaseline(benchmark::State& state) {
+    const auto obj = makeValue<T>();
+    if (!checkJson(state, obj)) {
+        return;
+    }
+    const auto json = reflecxx::toJsonString(obj);
+    T result{};
+    for (auto _ : state) {
+        baseline::read(json, result);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+
+} // namespace
+
+// Growing field count.
+#define BENCH_FLAT(benchmark)                          \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Fields4);  \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Fields4);  \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Fields16); \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Fields16); \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Fields64); \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Fields64)
+// Growing nesting depth.
+#define BENCH_NESTED(benchmark)                      \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Depth1); \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Depth1); \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Depth2); \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Depth2); \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Depth4); \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Depth4)
+// Growing enum size.
+#define BENCH_ENUM(benchmark)                        \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Enum4);  \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Enum4);  \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Enum16); \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Enum16); \
+    BENCHMARK_TEMPLATE(benchmark##Reflecxx, Enum64); \
+    BENCHMARK_TEMPLATE(benchmark##Baseline, Enum64)
+
+BENCH_FLAT(visit);
+BENCH_FLAT(get);
+BENCH_FLAT(compare);
+BENCH_NESTED(compare);
+BENCH_ENUM(enumName);
+BENCH_ENUM(fromName);
+BENCH_FLAT(toJson);
+BENCH_NESTED(toJson);
+BENCH_FLAT(fromJson);
+BENCH_NESTED(fromJson);
+
+BENCHMARK_MAIN();
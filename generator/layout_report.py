@@ -0,0 +1,230 @@
+# Copyright (c) 2021-2022 Jimmy O'Rourke
+# Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+# Official repository: https://github.com/jimmyorourke/reflecxx
+
+"""Memory layout report of annotated types, with suggested field orders that reduce padding."""
+
+from typing import Dict, Iterable, List, Optional, TextIO, Tuple
+
+from clang_reference.cindex import AccessSpecifier
+from clang_reference.cindex import Cursor
+from clang_reference.cindex import CursorKind
+
+HOT_ANNOTATION = "REFLECXX_HOT"
+
+
+def align_up(offset: int, alignment: int) -> int:
+    return (offset + alignment - 1) // alignment * alignment
+
+
+def is_hot(cursor: Cursor) -> bool:
+    return any(c.kind == CursorKind.ANNOTATE_ATTR and c.spelling == HOT_ANNOTATION for c in cursor.get_children())
+
+
+def access_name(access: AccessSpecifier) -> str:
+    if access == AccessSpecifier.PROTECTED:
+        return "protected"
+    if access == AccessSpecifier.PRIVATE:
+        return "private"
+    return "public"
+
+
+def is_virtual_base(base_specifier: Cursor) -> bool:
+    return any(t.spelling == "virtual" for t in base_specifier.get_tokens())
+
+
+def base_declaration(base_specifier: Cursor) -> Cursor:
+    return base_specifier.type.get_canonical().get_declaration()
+
+
+def is_dynamic(cursor: Cursor) -> bool:
+    """Returns true if objects of the class at cursor hold a vtable pointer, for its own virtual functions or virtual
+    bases or for those of a base class."""
+    for c in cursor.get_children():
+        if c.kind in (CursorKind.CXX_METHOD, CursorKind.DESTRUCTOR) and c.is_virtual_method():
+            return True
+        if c.kind == CursorKind.CXX_BASE_SPECIFIER and (is_virtual_base(c) or is_dynamic(base_declaration(c))):
+            return True
+    return False
+
+
+def has_own_vtable_pointer(cursor: Cursor) -> bool:
+    """Returns true if the class at cursor adds a vtable pointer, rather than sharing that of a non-virtual base class
+    as the Itanium C++ ABI does."""
+    return is_dynamic(cursor) and not any(
+        c.kind == CursorKind.CXX_BASE_SPECIFIER and not is_virtual_base(c) and is_dynamic(base_declaration(c))
+        for c in cursor.get_children()
+    )
+
+
+def field_bytes(fields: Iterable[Cursor]) -> int:
+    """Returns the number of bytes the fields occupy. Bit-fields sharing a byte count it once."""
+    ranges = []
+    for c in fields:
+        offset = c.get_field_offsetof()
+        if c.is_bitfield():
+            ranges.append((offset // 8, (offset + c.get_bitfield_width() + 7) // 8))
+        else:
+            ranges.append((offset // 8, offset // 8 + c.type.get_size()))
+    total = 0
+    end = 0
+    for start, stop in sorted(ranges):
+        total += max(stop - max(start, end), 0)
+        end = max(end, stop)
+    return total
+
+
+def data_bytes(cursor: Cursor) -> Tuple[int, int]:
+    """Returns the number of bytes taken by the fields of the class at cursor, including those of its base classes, and
+    the number of vtable pointers it holds, i.e. everything but its padding. The pointers are counted separately since
+    their size isn't known here."""
+    fields = [c for c in cursor.get_children() if c.kind == CursorKind.FIELD_DECL]
+    size = field_bytes(fields)
+    pointers = 1 if has_own_vtable_pointer(cursor) else 0
+    for c in cursor.get_children():
+        if c.kind == CursorKind.CXX_BASE_SPECIFIER:
+            base_size, base_pointers = data_bytes(base_declaration(c))
+            size += base_size
+            pointers += base_pointers
+    return size, pointers
+
+
+def cache_lines_spanned(fields: List[Dict], cache_line_size: int) -> int:
+    """Returns the number of cache lines the fields touch, for an object starting on a cache line boundary."""
+    lines = set()
+    for f in fields:
+        lines.update(range(f["offset"] // cache_line_size, (f["offset"] + f["size"] - 1) // cache_line_size + 1))
+    return len(lines)
+
+
+def lay_out(fields: List[Dict], start: int) -> List[Dict]:
+    """Returns copies of the fields with the offsets they would have if declared in the given order, after start bytes
+    taken by base classes or a vtable pointer."""
+    offset = start
+    placed = []
+    for f in fields:
+        offset = align_up(offset, f["alignment"])
+        placed.append({**f, "offset": offset})
+        offset += f["size"]
+    return placed
+
+
+def record_size(fields: List[Dict], start: int, alignment: int) -> int:
+    end = max([f["offset"] + f["size"] for f in fields], default=start)
+    return align_up(max(end, 1), alignment)
+
+
+def suggest_order(fields: List[Dict], start: int, alignment: int, cache_line_size: int) -> List[Dict]:
+    """Returns the fields, laid out in the order that keeps the hot fields together at the front, and otherwise
+    minimizes padding. Since every size is a multiple of its alignment, decreasing alignment leaves no holes from an
+    aligned start. The cold fields may start misaligned after the hot ones, in which case increasing alignment can fill
+    the gap instead, so both are tried."""
+
+    def by_alignment(group: List[Dict], descending: bool) -> List[Dict]:
+        return sorted(group, key=lambda f: (f["alignment"], f["size"]), reverse=descending)
+
+    hot = by_alignment([f for f in fields if f["hot"]], True)
+    cold = [f for f in fields if not f["hot"]]
+    candidates = [lay_out(hot + by_alignment(cold, d), start) for d in (True, False)]
+    # Prefer the current order among equally good ones, so that nothing is suggested unless it helps.
+    candidates.insert(0, fields)
+
+    def cost(candidate: List[Dict]):
+        hot_lines = cache_lines_spanned([f for f in candidate if f["hot"]], cache_line_size)
+        return record_size(candidate, start, alignment), hot_lines
+
+    return min(candidates, key=cost)
+
+
+def struct_layout(cursor: Cursor, cache_line_size: int) -> Optional[Dict]:
+    """Returns the layout of the struct or class definition at cursor, or None if it has no layout, e.g. because it's a
+    template."""
+    size = cursor.type.get_size()
+    alignment = cursor.type.get_align()
+    if size < 0 or alignment < 0:
+        return None
+
+    fields = []
+    has_bitfields = False
+    for c in cursor.get_children():
+        if c.kind != CursorKind.FIELD_DECL:
+            continue
+        if c.is_bitfield():
+            has_bitfields = True
+        fields.append(
+            {
+                "name": c.spelling,
+                "type": c.type.spelling,
+                "offset": c.get_field_offsetof() // 8,
+                "size": c.type.get_size(),
+                "alignment": c.type.get_align(),
+                "access": access_name(c.access_specifier),
+                "hot": is_hot(c),
+            }
+        )
+
+    # Whatever precedes the first field belongs to base classes or a vtable pointer, which stay where they are.
+    start = min([f["offset"] for f in fields], default=size)
+    field_bytes = sum(f["size"] for f in fields)
+    hot = [f for f in fields if f["hot"]]
+    layout = {
+        "name": cursor.type.spelling,
+        "file": str(cursor.location.file.name) if cursor.location.file is not None else None,
+        "size": size,
+        "alignment": alignment,
+        "padding": size - start - field_bytes if not has_bitfields else None,
+        "cache_lines": (size + cache_line_size - 1) // cache_line_size,
+        "hot_cache_lines": cache_lines_spanned(hot, cache_line_size),
+        "fields": fields,
+    }
+    if has_bitfields or not fields:
+        # Bit-field storage can't be modelled field by field.
+        return layout
+
+    suggested = suggest_order(fields, start, alignment, cache_line_size)
+    suggested_size = record_size(suggested, start, alignment)
+    layout.update(
+        {
+            "suggested_order": [f["name"] for f in suggested],
+            "suggested_size": suggested_size,
+            "suggested_padding": suggested_size - start - field_bytes,
+            "suggested_hot_cache_lines": cache_lines_spanned([f for f in suggested if f["hot"]], cache_line_size),
+            "savings": size - suggested_size,
+        }
+    )
+    return layout
+
+
+def write_summary(report: Dict, out: TextIO) -> None:
+    """Writes a human readable summary of the report, worst types first."""
+    types = sorted(report["types"], key=lambda t: (t.get("savings", 0), t["padding"] or 0), reverse=True)
+    for t in types:
+        padding = "unknown padding (bit-fields)" if t["padding"] is None else f"{t['padding']} padding bytes"
+        print(f"{t['name']}: {t['size']} bytes, {padding}, {t['cache_lines']} cache line(s)", file=out)
+        # Types with bit-fields or without fields have no suggested order.
+        if "suggested_order" in t and (
+            t["savings"] > 0 or t["suggested_hot_cache_lines"] < t["hot_cache_lines"]
+        ):
+            print(
+                f"    reorder to save {t['savings']} bytes"
+                f" ({t['size']} -> {t['suggested_size']}, hot fields on {t['suggested_hot_cache_lines']} cache line(s)):"
+                f" {', '.join(t['suggested_order'])}",
+                file=out,
+            )
+    print(
+        f"{len(types)} types, {report['total_padding']} padding bytes, {report['total_savings']} bytes saved by"
+        " reordering",
+        file=out,
+    )
+
+
+def make_report(layouts: List[Dict], cache_line_size: int) -> Dict:
+    # Types declared in headers included by several inputs are seen once per input.
+    unique = {t["name"]: t for t in layouts}
+    types = sorted(unique.values(), key=lambda t: t["name"])
+    return {
+        "cache_line_size": cache_line_size,
+        "total_padding": sum(t["padding"] or 0 for t in types),
+        "total_savings": sum(t.get("savings", 0) for t in types),
+        "types": types,
+    }
@@ -3,12 +3,16 @@
 # Official repository: https://github.com/jimmyorourke/reflecxx
 
 import argparse
+import hashlib
+import json
 import sys
 import os
 
+from concurrent.futures import ProcessPoolExecutor
+from itertools import repeat
 from os import PathLike
 from pathlib import Path
-from typing import Dict, List, Optional
+from typing import Dict, Iterator, List, Optional, Set, Tuple
 
 import clang_reference as clang
 from clang_reference.cindex import Cursor
@@ -16,6 +20,7 @@ from clang_reference.cindex import CursorKind
 from clang_reference.cindex import TranslationUnit
 from clang_reference.cindex import AccessSpecifier
 
+import layout_report
 from parse_types import Structure, Enumeration
 from visitor_generator import VisitorGenerator
 
@@ -29,6 +34,29 @@ def find_annotate_attr(cursor: Cursor) -> Optional[Cursor]:
     return None
 
 
+def declaring_file(cursor: Cursor) -> Optional[str]:
+    """Returns the resolved path of the file in which the cursor is declared."""
+    return str(Path(cursor.location.file.name).resolve()) if cursor.location.file is not None else None
+
+
+def is_reflecxx_friend(cursor: Cursor) -> bool:
+    """Returns true if the cursor is the REFLECXX_FRIEND declaration, befriending every MetaStructInternal."""
+    return cursor.kind == CursorKind.FRIEND_DECL and any(
+        c.kind == CursorKind.CLASS_TEMPLATE and c.spelling == "MetaStructInternal" for c in cursor.get_children()
+    )
+
+
+def check_struct_layout(cursor: Cursor, fields: List[Cursor], structure: Structure) -> None:
+    """Records the offsets of the fields of the struct or class at cursor, and how much of it isn't reflected, if its
+    layout is known."""
+    if cursor.type.get_size() < 0 or any(f.get_field_offsetof() < 0 for f in fields):
+        return
+    structure.field_offsets = {f.spelling: f.get_field_offsetof() // 8 for f in fields}
+    unreflected = [f for f in fields if f.access_specifier != AccessSpecifier.PUBLIC and not structure.reflects_private]
+    pointers = 1 if layout_report.has_own_vtable_pointer(cursor) else 0
+    structure.unreflected_bytes = (layout_report.field_bytes(unreflected), pointers)
+
+
 def check_annotated_struct(cursor: Cursor, structures: Dict[str, Structure]) -> None:
     """Checks if a cursor is an annotated struct or class declaration. If so, parses it and ands it to the structures
     dict."""
@@ -36,10 +64,15 @@ def check_annotated_struct(cursor: Cursor, structures: Dict[str, Structure]) ->
         attr = find_annotate_attr(cursor)
         if attr is not None:
             # cursor.type.spelling is namespace qualified, whereas curosor.spelling and cursor.displayname are not.
-            structure = Structure(cursor.type.spelling, cursor.spelling, attr.spelling)
+            structure = Structure(cursor.type.spelling, cursor.spelling, attr.spelling, declaring_file(cursor))
             structures[cursor.type.spelling] = structure
+            fields = []
             for c in cursor.get_children():
+                if is_reflecxx_friend(c):
+                    structure.reflects_private = True
                 if c.kind == CursorKind.FIELD_DECL:
+                    fields.append(c)
+                    structure.field_order.append(c.spelling)
                     if c.access_specifier == AccessSpecifier.PUBLIC:
                         # Use canonical type to handle things like:
                         ## namespace ns {
@@ -57,6 +90,10 @@ def check_annotated_struct(cursor: Cursor, structures: Dict[str, Structure]) ->
                     # class is derived
                     # Set the derived object to None for now until we can determine if it has been relfected
                     structure.base_classes[c.type.get_canonical().spelling] = None
+                    structure.base_data_bytes[c.type.get_canonical().spelling] = layout_report.data_bytes(
+                        layout_report.base_declaration(c)
+                    )
+            check_struct_layout(cursor, fields, structure)
 
 
 def check_annotated_enum(cursor: Cursor, enums: List[Enumeration]) -> None:
@@ -64,62 +101,376 @@ def check_annotated_enum(cursor: Cursor, enums: List[Enumeration]) -> None:
     if cursor.kind == CursorKind.ENUM_DECL:
         attr = find_annotate_attr(cursor)
         if attr is not None:
-            enum = Enumeration(cursor.type.spelling, cursor.spelling, attr.spelling)
+            enum = Enumeration(cursor.type.spelling, cursor.spelling, attr.spelling, declaring_file(cursor))
             enums.append(enum)
             for c in cursor.get_children():
                 if c.kind == CursorKind.ENUM_CONSTANT_DECL:
                     enum.enumerators[c.spelling] = c.enum_value
 
 
-def main(
-    libclang_directory: PathLike, input_files: List[PathLike], output_folder: PathLike, flags: List[str], namespace: str
+class ParseCache:
+    """Content hash cache of the inputs generated by previous runs, persisted in the output folder. An input is up to
+    date if neither it, nor any of the files it transitively includes, nor the flags, nor the generator itself have
+    changed since its output was generated."""
+
+    FILE_NAME = "reflecxx_cache.json"
+    GENERATOR_SOURCES = ["parse.py", "parse_types.py", "visitor_generator.py"]
+
+    def __init__(self, output_folder: PathLike, flags: List[str]):
+        self._cache_file = Path(output_folder) / self.FILE_NAME
+        # Digests of files read during this run, since most inputs share most of their includes.
+        self._digests: Dict[str, bytes] = {}
+        salt = hashlib.sha256(" ".join(flags).encode())
+        for source in self.GENERATOR_SOURCES:
+            salt.update(self._digest(Path(__file__).parent / source))
+        self._salt = salt.digest()
+        try:
+            self._entries: Dict[str, Dict] = json.loads(self._cache_file.read_text())
+        except (OSError, ValueError):
+            self._entries = {}
+
+    def is_up_to_date(self, file: PathLike, output_file: PathLike) -> bool:
+        entry = self._entries.get(self._key(file))
+        if entry is None or not Path(output_file).exists():
+            return False
+        return entry["hash"] == self._hash(file, entry["includes"])
+
+    def update(self, file: PathLike, includes: List[str]) -> None:
+        self._entries[self._key(file)] = {"hash": self._hash(file, includes), "includes": includes}
+
+    def save(self) -> None:
+        self._cache_file.write_text(json.dumps(self._entries, indent=2))
+
+    @staticmethod
+    def _key(file: PathLike) -> str:
+        return str(Path(file).resolve())
+
+    def _digest(self, file: PathLike) -> bytes:
+        key = str(file)
+        if key not in self._digests:
+            try:
+                self._digests[key] = hashlib.sha256(Path(file).read_bytes()).digest()
+            except OSError:
+                # A deleted include will change the hash and cause a reparse, which then reports the error.
+                self._digests[key] = b""
+        return self._digests[key]
+
+    def _hash(self, file: PathLike, includes: List[str]) -> str:
+        h = hashlib.sha256(self._salt)
+        for f in [file, *includes]:
+            h.update(str(f).encode())
+            h.update(self._digest(f))
+        return h.hexdigest()
+
+
+def output_file_for(output_folder: PathLike, file: PathLike) -> Path:
+    return Path(output_folder) / (Path(file).name + ".reflecxx_generated.hpp")
+
+
+def write_depfile(output_file: PathLike, file: PathLike, includes: List[str]) -> None:
+    """Writes a Make style depfile, <output_file>.d, listing everything output_file was generated from, so that build
+    systems can regenerate it when any of its includes change."""
+
+    def escape(path: PathLike) -> str:
+        return str(path).replace("\\", "/").replace(" ", "\\ ").replace("$", "$$")
+
+    deps = " \\\n  ".join(escape(Path(f).resolve()) for f in [file, *includes])
+    Path(str(output_file) + ".d").write_text(f"{escape(output_file)}: \\\n  {deps}\n")
+
+
+# libclang index for the current process. Each worker process needs its own.
+_index = None
+
+
+def init_libclang(libclang_directory: PathLike) -> None:
+    global _index
+    # Forked workers inherit an already loaded library.
+    if not clang.cindex.Config.loaded:
+        clang.cindex.Config.set_library_path(libclang_directory)
+    _index = clang.cindex.Index.create()
+
+
+def check_diagnostics(tu: TranslationUnit, file: PathLike, flags: List[str]) -> bool:
+    """Prints the diagnostics from parsing file. Returns False if any of them are errors."""
+    for diag in tu.diagnostics:
+        # TODO: log level?
+        print("Parse diagostic", diag)
+        # we can get warnings from unused commandline args
+        if diag.severity > diag.Warning:
+            print(f"Code generation failed for {file}.")
+            print("Flags:", flags)
+            return False
+    return True
+
+
+def included_files(tu: TranslationUnit) -> Set[str]:
+    return {str(i.include.name) for i in tu.get_includes()}
+
+
+class PrecompiledHeader:
+    """Precompiled prefix header, for the headers that every input includes, such as the standard library. It is built
+    once per flag set and reused by each input's parse, including by later runs and other generator processes sharing the
+    output folder. It is rebuilt when the prefix header or the flags change, or any of the files it includes is newer
+    than it."""
+
+    def __init__(self, prefix_header: PathLike, output_folder: PathLike, flags: List[str]):
+        self._prefix_header = prefix_header
+        self._flags = flags
+        key = hashlib.sha256(Path(prefix_header).read_bytes() + " ".join(flags).encode()).hexdigest()[:16]
+        self.path = Path(output_folder) / f"reflecxx_{key}.pch"
+        self._deps_file = Path(str(self.path) + ".deps")
+        # Everything in the precompiled header, which the translation units using it don't report as included.
+        self.includes: List[str] = []
+
+    def build(self) -> bool:
+        """Builds the precompiled header if it is missing or out of date. Returns False if parsing failed."""
+        if self._is_current():
+            self.includes = self._deps_file.read_text().splitlines()
+            return True
+
+        # The prefix header may well be named .h, so make sure it's treated as C++.
+        options = TranslationUnit.PARSE_INCOMPLETE | TranslationUnit.PARSE_SKIP_FUNCTION_BODIES
+        args = self._flags + ["-x", "c++-header"]
+        tu = TranslationUnit.from_source(self._prefix_header, args=args, options=options, index=_index)
+        if not check_diagnostics(tu, self._prefix_header, args):
+            return False
+        self.includes = sorted({str(Path(self._prefix_header).resolve())} | included_files(tu))
+
+        # Other generator processes may be using or building the same one, so replace it atomically.
+        suffix = f".{os.getpid()}.tmp"
+        tu.save(str(self.path) + suffix)
+        Path(str(self._deps_file) + suffix).write_text("\n".join(self.includes))
+        os.replace(str(self._deps_file) + suffix, self._deps_file)
+        os.replace(str(self.path) + suffix, self.path)
+        return True
+
+    def _is_current(self) -> bool:
+        if not self.path.exists() or not self._deps_file.exists():
+            return False
+        built = self.path.stat().st_mtime
+        for f in self._deps_file.read_text().splitlines():
+            if not Path(f).exists() or Path(f).stat().st_mtime > built:
+                return False
+        return True
+
+
+def parse(
+    file: PathLike, flags: List[str], pch: Optional[PrecompiledHeader], unsaved_files=None
+) -> Optional[TranslationUnit]:
+    """Parses file, using the precompiled header if there is one. Returns None if parsing failed."""
+    if pch is not None:
+        flags = flags + ["-include-pch", str(pch.path)]
+    # speed up parsing
+    options = TranslationUnit.PARSE_SKIP_FUNCTION_BODIES
+    tu = TranslationUnit.from_source(file, args=flags, unsaved_files=unsaved_files, options=options, index=_index)
+    return tu if check_diagnostics(tu, file, flags) else None
+
+
+# Cursor kinds which can contain struct, class or enum declarations.
+SCOPE_KINDS = {
+    CursorKind.TRANSLATION_UNIT,
+    CursorKind.NAMESPACE,
+    CursorKind.LINKAGE_SPEC,
+    CursorKind.UNEXPOSED_DECL,
+    CursorKind.STRUCT_DECL,
+    CursorKind.CLASS_DECL,
+}
+
+
+def walk_declarations(cursor: Cursor) -> Iterator[Cursor]:
+    """Walks cursor and its descendants in preorder, like Cursor.walk_preorder(), but without descending into anything
+    that can't contain a type declaration, such as functions and templates. Visiting every cursor of the standard library
+    headers would otherwise take longer than parsing them."""
+    yield cursor
+    if cursor.kind in SCOPE_KINDS:
+        for c in cursor.get_children():
+            yield from walk_declarations(c)
+
+
+def find_annotated(tu: TranslationUnit) -> Tuple[Dict[str, Structure], List[Enumeration]]:
+    """Returns all the annotated structures, by name, and enums in the translation unit."""
+    # Dict of name to Structure. Use a dict so after parsing all annotated structures we can efficiently look up whether
+    # base classes were annotated or not.
+    structures = {}
+    enums = []
+
+    for cursor in walk_declarations(tu.cursor):
+        check_annotated_struct(cursor, structures)
+        check_annotated_enum(cursor, enums)
+
+    # With all structures parsed, base classes can be pointed to if they were annotated.
+    for s in structures.values():
+        for base_class in s.base_classes:
+            if base_class in structures:
+                s.base_classes[base_class] = structures[base_class]
+    return structures, enums
+
+
+def generate_output(
+    file: PathLike, output_file: PathLike, structures: Dict[str, Structure], enums: List[Enumeration], namespace: str
+) -> None:
+    """Generates output_file from the annotated types declared in file. Those declared in the headers it includes are
+    generated from those headers instead, otherwise they would be defined twice wherever both are included."""
+    declaring_file = str(Path(file).resolve())
+    with VisitorGenerator(output_file=output_file, namespace=namespace) as v:
+        for s in structures.values():
+            if s.annotation == v.ANNOTATION and s.file == declaring_file:
+                v.generate_meta_struct(s)
+        for e in enums:
+            if e.annotation == v.ANNOTATION and e.file == declaring_file:
+                v.generate_meta_enum(e)
+
+
+def generate_file(
+    file: PathLike, output_file: PathLike, flags: List[str], namespace: str, pch: Optional[PrecompiledHeader]
+) -> Optional[List[str]]:
+    """Parses file and generates output_file from its annotated types. Returns the files transitively included by file,
+    or None if parsing failed."""
+    tu = parse(file, flags, pch)
+    if tu is None:
+        return None
+    structures, enums = find_annotated(tu)
+    generate_output(file, output_file, structures, enums, namespace)
+    return sorted(included_files(tu) | set(pch.includes if pch is not None else []))
+
+
+def generate_combined(
+    files: List[PathLike],
+    output_files: List[PathLike],
+    flags: List[str],
+    namespace: str,
+    pch: Optional[PrecompiledHeader],
+) -> List[Optional[List[str]]]:
+    """Parses all the files as a single translation unit, and generates each of their outputs from it, so that includes
+    shared between them are only parsed once. The files must be able to be included together. Returns the files each
+    output was generated from, or None for all of them if parsing failed."""
+    combined = "reflecxx_combined.hpp"
+    source = "".join(f'#include "{Path(f).resolve().as_posix()}"\n' for f in files)
+    tu = parse(combined, flags, pch, unsaved_files=[(combined, source)])
+    if tu is None:
+        return [None] * len(files)
+    structures, enums = find_annotated(tu)
+    for file, output_file in zip(files, output_files):
+        generate_output(file, output_file, structures, enums, namespace)
+    # Which of the shared includes each file needed isn't known, so each output depends on all of them.
+    includes = sorted(included_files(tu) | set(pch.includes if pch is not None else []))
+    return [includes] * len(files)
+
+
+def report_file(
+    file: PathLike, flags: List[str], pch: Optional[PrecompiledHeader], cache_line_size: int
+) -> Optional[List[Dict]]:
+    """Parses file and returns the layouts of the annotated structs and classes declared in it, or None if parsing
+    failed."""
+    tu = parse(file, flags, pch)
+    if tu is None:
+        return None
+    file = str(Path(file).resolve())
+    layouts = []
+    for cursor in walk_declarations(tu.cursor):
+        if (
+            cursor.kind in (CursorKind.STRUCT_DECL, CursorKind.CLASS_DECL)
+            and cursor.is_definition()
+            and find_annotate_attr(cursor) is not None
+            and declaring_file(cursor) == file
+        ):
+            layout = layout_report.struct_layout(cursor, cache_line_size)
+            if layout is not None:
+                layouts.append(layout)
+    return layouts
+
+
+def write_layout_report(
+    libclang_directory: PathLike,
+    input_files: List[PathLike],
+    report_file_path: PathLike,
+    flags: List[str],
+    jobs: int,
+    prefix_header: Optional[PathLike],
+    cache_line_size: int,
 ):
-    clang.cindex.Config.set_library_path(libclang_directory)
-    index = clang.cindex.Index.create()
+    """Writes the layout report of the annotated types in the inputs to report_file_path as JSON, and prints a
+    summary."""
+    flags.append("-DREFLECXX_GENERATION")
+    init_libclang(libclang_directory)
+    pch = None
+    if prefix_header is not None:
+        pch = PrecompiledHeader(prefix_header, Path(report_file_path).parent, flags)
+        if not pch.build():
+            exit(1)
+
+    args = (input_files, repeat(flags), repeat(pch), repeat(cache_line_size))
+    if jobs > 1 and len(input_files) > 1:
+        with ProcessPoolExecutor(
+            max_workers=min(jobs, len(input_files)), initializer=init_libclang, initargs=(libclang_directory,)
+        ) as pool:
+            results = list(pool.map(report_file, *args))
+    else:
+        results = list(map(report_file, *args))
+    if any(r is None for r in results):
+        exit(1)
+
+    report = layout_report.make_report([layout for r in results for layout in r], cache_line_size)
+    Path(report_file_path).write_text(json.dumps(report, indent=2))
+    layout_report.write_summary(report, sys.stdout)
 
+
+def main(
+    libclang_directory: PathLike,
+    input_files: List[PathLike],
+    output_folder: PathLike,
+    flags: List[str],
+    namespace: str,
+    jobs: int,
+    use_cache: bool,
+    depfiles: bool,
+    prefix_header: Optional[PathLike],
+    combined: bool,
+):
     flags.append("-DREFLECXX_GENERATION")
+    os.makedirs(output_folder, exist_ok=True)
 
-    for file in input_files:
-        # Dict of name to Structure. Use a dict so after parsing all annotated structures we can efficiently look up whether
-        # base classes were annotated or not.
-        structures = {}
-        enums = []
-
-        # compile
-        # speed up parsing
-        options = TranslationUnit.PARSE_SKIP_FUNCTION_BODIES
-        tu = TranslationUnit.from_source(file, args=flags, unsaved_files=None, options=options, index=index)
-
-        for diag in tu.diagnostics:
-            # TODO: log level?
-            print("Parse diagostic", diag)
-            # we can get warnings from unused commandline args
-            if diag.severity > diag.Warning:
-                print("Code generation failed.")
-                print("Flags:", flags)
-                exit(1)
-
-        for cursor in tu.cursor.walk_preorder():
-            check_annotated_struct(cursor, structures)
-            check_annotated_enum(cursor, enums)
-
-        # With all structures parsed, base classes can be pointed to if they were annotated.
-        for s in structures.values():
-            for base_class in s.base_classes:
-                if base_class in structures:
-                    s.base_classes[base_class] = structures[base_class]
+    # Inputs whose outputs are up to date are skipped entirely, leaving the outputs untouched so that nothing including
+    # them needs to be rebuilt.
+    cache = ParseCache(output_folder, flags) if use_cache else None
+    outputs = [output_file_for(output_folder, file) for file in input_files]
+    stale = [(f, o) for f, o in zip(input_files, outputs) if cache is None or not cache.is_up_to_date(f, o)]
+    if not stale:
+        return
+
+    init_libclang(libclang_directory)
+    pch = None
+    if prefix_header is not None:
+        pch = PrecompiledHeader(prefix_header, output_folder, flags)
+        if not pch.build():
+            exit(1)
 
-        # Generate!
-        os.makedirs(output_folder, exist_ok=True)
-        output_file = Path(output_folder) / (Path(file).name + ".reflecxx_generated.hpp")
+    stale_files, stale_outputs = zip(*stale)
+    args = (stale_files, stale_outputs, repeat(flags), repeat(namespace), repeat(pch))
+    if combined:
+        results = generate_combined(list(stale_files), list(stale_outputs), flags, namespace, pch)
+    elif jobs > 1 and len(stale) > 1:
+        # Each translation unit is parsed independently, so they can be spread across processes.
+        with ProcessPoolExecutor(
+            max_workers=min(jobs, len(stale)), initializer=init_libclang, initargs=(libclang_directory,)
+        ) as pool:
+            results = list(pool.map(generate_file, *args))
+    else:
+        results = list(map(generate_file, *args))
 
-        with VisitorGenerator(output_file=output_file, namespace=namespace) as v:
-            for s in structures.values():
-                if s.annotation == v.ANNOTATION:
-                    v.generate_meta_struct(s)
-            for e in enums:
-                if e.annotation == v.ANNOTATION:
-                    v.generate_meta_enum(e)
+    failed = False
+    for file, output_file, includes in zip(stale_files, stale_outputs, results):
+        if includes is None:
+            failed = True
+            continue
+        if cache is not None:
+            cache.update(file, includes)
+        if depfiles:
+            write_depfile(output_file, file, includes)
+    if cache is not None:
+        cache.save()
+    if failed:
+        exit(1)
 
 
 if __name__ == "__main__":
@@ -138,9 +489,58 @@ if __name__ == "__main__":
         " separated as would appear on the commandline. Needs to be specified as --flags=",
         default="",
     )
+    parser.add_argument(
+        "--jobs", "-j", type=int, default=os.cpu_count(), help="Number of input files to parse in parallel"
+    )
+    parser.add_argument(
+        "--no-cache", action="store_true", help="Regenerate all inputs, even those unchanged since the last run"
+    )
+    parser.add_argument(
+        "--depfiles", action="store_true", help="Write a Make style <output>.d depfile for each generated output"
+    )
+    parser.add_argument(
+        "--prefix-header",
+        help="Header including what most inputs include, e.g. standard library headers, to be precompiled once and"
+        " reused for every input",
+    )
+    parser.add_argument(
+        "--layout-report",
+        help="Instead of generating code, write a JSON report of the size, padding and cache line footprint of each"
+        " annotated struct or class, with field orders that reduce padding, to this file, and print a summary",
+    )
+    parser.add_argument(
+        "--cache-line-size", type=int, default=64, help="Cache line size in bytes, for the layout report"
+    )
+    parser.add_argument(
+        "--combined",
+        action="store_true",
+        help="Parse all inputs as a single translation unit, rather than one per input. They must be includable together",
+    )
     args = parser.parse_args()
 
     # since we're going to be specializing some templates, we have to use the same namespace as the original
     # declarations
     namespace = "reflecxx::detail"
-    main(args.libclang_directory, args.input_files, args.output_folder, args.flags.split(), namespace)
+    if args.layout_report is not None:
+        write_layout_report(
+            args.libclang_directory,
+            args.input_files,
+            args.layout_report,
+            args.flags.split(),
+            args.jobs,
+            args.prefix_header,
+            args.cache_line_size,
+        )
+        sys.exit(0)
+    main(
+        args.libclang_directory,
+        args.input_files,
+        args.output_folder,
+        args.flags.split(),
+        namespace,
+        args.jobs,
+        not args.no_cache,
+        args.depfiles,
+        args.prefix_header,
+        args.combined,
+    )
@@ -4,30 +4,53 @@
 
 """Classes representing the types parsed by libclang."""
 
-from typing import Dict, Optional, Union
+from typing import Dict, List, Optional, Tuple, Union
 
 
 class Structure:
     """Represents a C or C++ Struct or Class."""
 
-    def __init__(self, qualified_typename: str, name: Optional[str] = None, annotation: Optional[str] = None):
+    def __init__(
+        self,
+        qualified_typename: str,
+        name: Optional[str] = None,
+        annotation: Optional[str] = None,
+        file: Optional[str] = None,
+    ):
         self.qualified_typename: str = qualified_typename
         self.name: str = name if name else qualified_typename
         # name to Structure
         self.private_fields: Dict[str, "Structure"] = {}
         self.protected_fields: Dict[str, "Structure"] = {}
         self.public_fields: Dict[str, "Structure"] = {}
+        # names of all fields, in declaration order
+        self.field_order: List[str] = []
+        # whether the private and protected fields are reflected too, through a friend declaration
+        self.reflects_private: bool = False
         # name to Structure if base is reflected, else name to None
         self.base_classes: Dict[str, Union["Structure", None]] = {}
+        # byte offset of each field, None if the layout isn't known, e.g. for a class template
+        self.field_offsets: Optional[Dict[str, int]] = None
+        # bytes and vtable pointers that aren't reflected: the non-public fields, unless reflects_private, and a vtable
+        # pointer of its own
+        self.unreflected_bytes: Tuple[int, int] = (0, 0)
+        # name to the bytes and vtable pointers of each base class, counted as unreflected for bases that aren't
+        self.base_data_bytes: Dict[str, Tuple[int, int]] = {}
         self.annotation: str = annotation
+        # file the declaration is in
+        self.file: Optional[str] = file
 
 
 class Enumeration:
     """Represents a C++ scoped enum or a C or C++ unscoped enum."""
 
-    def __init__(self, qualified_name: str, name: Optional[str] = None, annotation: Optional[str] = None):
+    def __init__(
+        self, qualified_name: str, name: Optional[str] = None, annotation: Optional[str] = None, file: Optional[str] = None
+    ):
         self.qualified_name: str = qualified_name
         self.name: str = name if name else qualified_name
         # unqualified name to value mappings
         self.enumerators: Dict[str, int] = {}
         self.annotation: str = annotation
+        # file the declaration is in
+        self.file: Optional[str] = file
@@ -6,6 +6,7 @@ import os
 import sys
 
 from datetime import datetime
+from typing import Dict, List
 from parse_types import Structure, Enumeration
 
 
@@ -48,6 +49,8 @@ class VisitorGenerator():
         self._output("#pragma once\n")
         self._output(f"// Autogenerated at {datetime.now()} by {__file__}.")
         self._output("// Do not edit, changes will be overwritten!\n")
+        self._output("#include <array>")
+        self._output("#include <cstddef>")
         self._output("#include <type_traits>")
         self._output("")
         self._output("#include <reflecxx/types.hpp>")
@@ -69,16 +72,14 @@ class VisitorGenerator():
         with IndentBlock(self):
             self._output(f"using Type = {s.qualified_typename};")
             self._output(f'static constexpr std::string_view name{{"{s.name}"}};')
-            self._output("static constexpr auto publicFields = std::make_tuple(")
-            with IndentBlock(self):
-                # make_tuple doesn't allow trailing commas so we have to keep track
-                size = len(s.public_fields)
-                count = 1
-                for field_name, field_struct in s.public_fields.items():
-                    suffix = "," if count < size else ""
-                    count += 1
-                    self._output(f'ClassMember<Type, {field_struct.qualified_typename}>{{&Type::{field_name}, "{field_name}"}}{suffix}')
-            self._output(");")
+            self._generate_fields("publicFields", s.public_fields)
+            reflected_fields = list(s.public_fields)
+            if s.reflects_private:
+                # Only accessible because the class befriends MetaStructInternal.
+                non_public_fields = {**s.protected_fields, **s.private_fields}
+                private_fields = {name: non_public_fields[name] for name in s.field_order if name in non_public_fields}
+                self._generate_fields("privateFields", private_fields)
+                reflected_fields += list(private_fields)
 
             self._output("static constexpr auto baseClasses = std::make_tuple(")
             with IndentBlock(self):
@@ -93,9 +94,52 @@ class VisitorGenerator():
                     else:
                         self._output(f"// skipping unannotated base class {name}")
             self._output(");")
+            if s.field_offsets is not None:
+                self._generate_layout(s, reflected_fields)
         self._output("};")
         self._output("")
 
+    def _generate_fields(self, tuple_name: str, fields: Dict[str, Structure]):
+        self._output(f"static constexpr auto {tuple_name} = std::make_tuple(")
+        with IndentBlock(self):
+            # make_tuple doesn't allow trailing commas so we have to keep track
+            size = len(fields)
+            count = 1
+            for field_name, field_struct in fields.items():
+                suffix = "," if count < size else ""
+                count += 1
+                self._output(f'ClassMember<Type, {field_struct.qualified_typename}>{{&Type::{field_name}, "{field_name}"}}{suffix}')
+        self._output(");")
+
+    def _generate_layout(self, s: Structure, reflected_fields: List[str]):
+        # offsetof is only valid for standard layout types, the others get the offsets the generator laid them out at.
+        # Being a template delays checking offsetof until it's known to be valid.
+        self._output("template <typename U = Type>")
+        self._output(f"static constexpr std::array<size_t, {len(reflected_fields)}> fieldOffsets() {{")
+        with IndentBlock(self):
+            if reflected_fields:
+                self._output("if constexpr (std::is_standard_layout_v<U>) {")
+                with IndentBlock(self):
+                    self._output(f"return {{{', '.join(f'offsetof(U, {name})' for name in reflected_fields)}}};")
+                self._output("} else {")
+                with IndentBlock(self):
+                    self._output(f"return {{{', '.join(str(s.field_offsets[name]) for name in reflected_fields)}}};")
+                self._output("}")
+            else:
+                self._output("return {};")
+        self._output("}")
+
+        # Unreflected bases count their fields and vtable pointers, but not their padding.
+        size, pointers = s.unreflected_bytes
+        for name, base in s.base_classes.items():
+            if base is None:
+                size += s.base_data_bytes[name][0]
+                pointers += s.base_data_bytes[name][1]
+        terms = [str(size)] if size or not pointers else []
+        if pointers:
+            terms.append("sizeof(void*)" if pointers == 1 else f"{pointers} * sizeof(void*)")
+        self._output(f"static constexpr size_t unreflectedBytes{{{' + '.join(terms)}}};")
+
     def generate_meta_enum(self, e: Enumeration):
         self._output("////////////////////////////////////////////////////////////")
         self._output(f"// {e.qualified_name}")
@@ -9,6 +9,8 @@
 
 // Annotate a type with this macro to generate Reflecxx visitor acceptors.
 #define REFLECXX_T __attribute__((annotate("REFLECXX_GEN: Reflection Visitor")))
+// Annotate a field with this macro to mark it as frequently accessed, for the generator's layout report.
+#define REFLECXX_HOT __attribute__((annotate("REFLECXX_HOT")))
 // Include a null header during code generation.
 #define REFLECXX_HEADER(include_file) <reflecxx/detail/empty.hpp>
 // Null implementation of helper wrapper for defining comparison operators in header files that go through code
@@ -21,9 +23,22 @@
 
 // Do nothing.
 #define REFLECXX_T
+#define REFLECXX_HOT
 // Include the generated file containing the Reflecxx acceptors.
 #define REFLECXX_HEADER(include_file) <generated_headers/include_file.reflecxx_generated.hpp>
 // Helper wrapper for defining comparison operators in header files that go through code generation.
 #define REFLECXX_CMP(lhs, rhs, op) reflecxx::compare(lhs, rhs, op)
 
 #endif // REFLECXX_GENERATION
+
+namespace reflecxx::detail {
+template <typename T>
+struct MetaStructInternal;
+} // namespace reflecxx::detail
+
+// Declare in the body of an annotated class to also reflect its private and protected fields, following the public
+// ones. Befriends the generated metadata so that it can point to them, after which they're visited, serialized, hashed
+// and compared in place like public fields.
+#define REFLECXX_FRIEND \
+    template <typename> \
+    friend struct ::reflecxx::detail::MetaStructInternal
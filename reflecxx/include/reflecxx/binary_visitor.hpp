@@ -0,0 +1,238 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/flags.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+// Compact binary serialization of reflecxx visitable types.
+// Fields are written in visitation order with no padding or framing, in native byte order, so the format is intended
+// for exchange between processes on the same platform built against the same type definitions. Supported field types
+// are arithmetic types, enums, reflecxx::flags, C-style arrays, std::arrays, and nested visitable types, all of which
+// have a fixed size, so the serialized size of a type is a compile-time constant.
+
+namespace reflecxx {
+
+// Returns the number of bytes T serializes to.
+template <typename T>
+constexpr size_t binarySize();
+
+// Serializes value into out, which must have room for binarySize<T>() bytes. Returns the end of the written bytes.
+template <typename T>
+std::byte* toBinary(const T& value, std::byte* out);
+
+// Serializes value into an array of bytes.
+template <typename T>
+std::array<std::byte, binarySize<T>()> toBinary(const T& value);
+
+// Deserializes value from in, which must hold binarySize<T>() bytes. Returns the end of the consumed bytes.
+template <typename T>
+const std::byte* fromBinary(const std::byte* in, T& value);
+
+namespace detail {
+
+template <typename T>
+constexpr bool isPackedBinary();
+
+// True if the in-memory representation of T is byte for byte identical to its serialized representation, such that it
+// can be copied with a single memcpy.
+template <typename T>
+inline constexpr bool is_packed_binary_v = isPackedBinary<T>();
+
+template <typename T>
+constexpr bool isPackedBinary() {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || is_flags<T>::value) {
+        return true;
+    } else if constexpr (std::is_array_v<T>) {
+        return is_packed_binary_v<std::remove_extent_t<T>>;
+    } else if constexpr (is_std_array<T>::value) {
+        return is_packed_binary_v<typename T::value_type> && sizeof(T) == binarySize<T>();
+    } else if constexpr (!is_reflecxx_visitable_v<T>) {
+        return false;
+    } else {
+        // Without base classes, the fields of a standard layout struct are laid out in declaration order, so if they
+        // also account for every byte of the object, memory order matches visitation order and there is no padding.
+        // Standard layout also rules out mixed access, where private fields are visited after public ones.
+        return std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> &&
+               std::tuple_size_v<decltype(MetaStruct<T>::baseClasses)> == 0 && sizeof(T) == binarySize<T>();
+    }
+}
+
+// Accumulates runs of packed fields that are adjacent in memory, so that each run is copied with a single memcpy.
+// Field addresses come from the ClassMember pointers of the instance being visited; when optimizing, the compiler folds
+// them into constant offsets.
+struct BinaryRun {
+    // Returns true if the size bytes at address directly continue the current run, in which case the run is extended.
+    bool extend(const void* address, size_t size) {
+        if (length > 0 && start + length == reinterpret_cast<uintptr_t>(address)) {
+            length += size;
+            return true;
+        }
+        return false;
+    }
+
+    void reset(const void* address, size_t size) {
+        start = reinterpret_cast<uintptr_t>(address);
+        length = size;
+    }
+
+    std::byte* data() const { return reinterpret_cast<std::byte*>(start); }
+
+    uintptr_t start{};
+    size_t length{};
+};
+
+} // namespace detail
+
+// Visitor functor for serializing named values (such as class members) to a binary buffer.
+struct ToBinaryVisitor {
+    ToBinaryVisitor(std::byte* out)
+    : out(out) {}
+
+    template <typename T>
+    void operator()(std::string_view, const T& member) {
+        write(member);
+    }
+
+    // Writes any pending run of bytes, returning the end of the written bytes.
+    std::byte* flush() {
+        if (run.length > 0) {
+            std::memcpy(out, run.data(), run.length);
+            out += run.length;
+            run.reset(nullptr, 0);
+        }
+        return out;
+    }
+
+    std::byte* out;
+
+ private:
+    template <typename T>
+    void write(const T& value) {
+        if constexpr (detail::is_packed_binary_v<T>) {
+            if (!run.extend(&value, sizeof(T))) {
+                flush();
+                run.reset(&value, sizeof(T));
+            }
+        } else if constexpr (std::is_array_v<T> || detail::is_std_array<T>::value) {
+            for (const auto& item : value) {
+                write(item);
+            }
+        } else {
+            static_assert(is_reflecxx_visitable_v<T>, "Type is not supported by binary serialization!");
+            visit(value, *this);
+        }
+    }
+
+    detail::BinaryRun run;
+};
+
+// Visitor functor for deserializing named objects (such as class members) from a binary buffer.
+struct FromBinaryVisitor {
+    FromBinaryVisitor(const std::byte* in)
+    : in(in) {}
+
+    template <typename T>
+    void operator()(std::string_view, T& member) {
+        read(member);
+    }
+
+    // Reads any pending run of bytes, returning the end of the consumed bytes.
+    const std::byte* flush() {
+        if (run.length > 0) {
+            std::memcpy(run.data(), in, run.length);
+            in += run.length;
+            run.reset(nullptr, 0);
+        }
+        return in;
+    }
+
+    const std::byte* in;
+
+ private:
+    template <typename T>
+    void read(T& value) {
+        if constexpr (detail::is_packed_binary_v<T>) {
+            if (!run.extend(&value, sizeof(T))) {
+                flush();
+                run.reset(&value, sizeof(T));
+            }
+        } else if constexpr (std::is_array_v<T> || detail::is_std_array<T>::value) {
+            for (auto& item : value) {
+                read(item);
+            }
+        } else {
+            static_assert(is_reflecxx_visitable_v<T>, "Type is not supported by binary serialization!");
+            visit(value, *this);
+        }
+    }
+
+    detail::BinaryRun run;
+};
+
+template <typename T>
+constexpr size_t binarySize() {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || detail::is_flags<T>::value) {
+        return sizeof(T);
+    } else if constexpr (std::is_array_v<T>) {
+        return std::extent_v<T> * binarySize<std::remove_extent_t<T>>();
+    } else if constexpr (detail::is_std_array<T>::value) {
+        return std::tuple_size_v<T> * binarySize<typename T::value_type>();
+    } else {
+        static_assert(is_reflecxx_visitable_v<T>, "Type is not supported by binary serialization!");
+        return std::apply(
+            [](const auto&... members) {
+                return (size_t{0} + ... + binarySize<typename detail::remove_cvref_t<decltype(members)>::type>());
+            },
+            detail::flatFields<T>);
+    }
+}
+
+template <typename T>
+std::byte* toBinary(const T& value, std::byte* out) {
+    if constexpr (detail::is_packed_binary_v<T>) {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    } else {
+        ToBinaryVisitor v{out};
+        visit(value, v);
+        return v.flush();
+    }
+}
+
+template <typename T>
+std::array<std::byte, binarySize<T>()> toBinary(const T& value) {
+    std::array<std::byte, binarySize<T>()> bytes;
+    toBinary(value, bytes.data());
+    return bytes;
+}
+
+template <typename T>
+const std::byte* fromBinary(const std::byte* in, T& value) {
+    if constexpr (detail::is_packed_binary_v<T>) {
+        std::memcpy(&value, in, sizeof(T));
+        return in + sizeof(T);
+    } else {
+        FromBinaryVisitor v{in};
+        visit(value, v);
+        return v.flush();
+    }
+}
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
@@ -0,0 +1,307 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/soa_vector.hpp>
+#include <reflecxx/span.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bulk operations over many records at once, either over a single column of values, over the I'th field of every row
+// of an soa_vector<T>, or over the I'th field of every element of a span of T.
+// The kernels are written as fixed width blocks of independent lanes, which the compiler maps directly onto SIMD
+// registers (SSE, AVX2, NEON, ...) for arithmetic columns, within the instruction set the code is compiled for.
+// Columns of an soa_vector are contiguous, making them the best case; fields of a span of T are strided by sizeof(T).
+
+namespace reflecxx {
+
+// Returns the sum of the values in column. Integral values are summed in 64 bits. Floating point values are summed in
+// several interleaved partial sums, so rounding may differ slightly from a sequential sum.
+template <typename V>
+auto sum(span<V> column);
+template <size_t I, typename T>
+auto sum(const soa_vector<T>& rows);
+template <size_t I, typename T>
+auto sum(span<T> rows);
+
+// Returns the smallest value in column, or std::nullopt if it's empty. Unspecified if the column contains NaN.
+template <typename V>
+auto min(span<V> column);
+template <size_t I, typename T>
+auto min(const soa_vector<T>& rows);
+template <size_t I, typename T>
+auto min(span<T> rows);
+
+// Returns the largest value in column, or std::nullopt if it's empty. Unspecified if the column contains NaN.
+template <typename V>
+auto max(span<V> column);
+template <size_t I, typename T>
+auto max(const soa_vector<T>& rows);
+template <size_t I, typename T>
+auto max(span<T> rows);
+
+// Returns the indices, in increasing order, of the values in column for which pred returns true.
+template <typename V, typename Predicate>
+std::vector<size_t> filter(span<V> column, Predicate&& pred);
+template <size_t I, typename T, typename Predicate>
+std::vector<size_t> filter(const soa_vector<T>& rows, Predicate&& pred);
+template <size_t I, typename T, typename Predicate>
+std::vector<size_t> filter(span<T> rows, Predicate&& pred);
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+// As above, for the field named Name, e.g. reflecxx::sum<"price">(rows). In C++17, the index of the field can be looked
+// up at compile time instead, e.g. reflecxx::sum<reflecxx::fieldIndex<T>("price")>(rows).
+template <fixed_string Name, typename Rows>
+auto sum(const Rows& rows) {
+    return sum<fieldIndex<typename Rows::value_type>(Name.view())>(rows);
+}
+template <fixed_string Name, typename Rows>
+auto min(const Rows& rows) {
+    return min<fieldIndex<typename Rows::value_type>(Name.view())>(rows);
+}
+template <fixed_string Name, typename Rows>
+auto max(const Rows& rows) {
+    return max<fieldIndex<typename Rows::value_type>(Name.view())>(rows);
+}
+template <fixed_string Name, typename Rows, typename Predicate>
+std::vector<size_t> filter(const Rows& rows, Predicate&& pred) {
+    return filter<fieldIndex<typename Rows::value_type>(Name.view())>(rows, std::forward<Predicate>(pred));
+}
+#endif
+
+// Sets out[i] to whether lhs[i] is equal to rhs[i], comparing each field. Throws std::invalid_argument if the sizes of
+// lhs, rhs and out differ.
+template <typename T>
+void equalTo(const soa_vector<T>& lhs, const soa_vector<T>& rhs, span<bool> out);
+template <typename T>
+void equalTo(span<T> lhs, span<T> rhs, span<bool> out);
+
+namespace detail {
+
+// Number of independent accumulators per reduction, enough to fill a 256 bit register with 32 bit values. Keeping the
+// lanes independent lets the compiler vectorize without having to reassociate floating point arithmetic.
+inline constexpr size_t reduceLanes = 8;
+
+template <typename V>
+using sum_t = std::conditional_t<std::is_floating_point_v<V>, V,
+                                 std::conditional_t<std::is_signed_v<V>, int64_t, uint64_t>>;
+
+template <typename V>
+constexpr void checkReducible() {
+    static_assert(std::is_arithmetic_v<V> && !std::is_same_v<V, bool>, "Reductions require an arithmetic type!");
+}
+
+// Sums get(i) for i in [0, n).
+template <typename V, typename Getter>
+sum_t<V> sumKernel(size_t n, const Getter& get) {
+    checkReducible<V>();
+    std::array<sum_t<V>, reduceLanes> lanes{};
+    size_t i = 0;
+    for (; i + reduceLanes <= n; i += reduceLanes) {
+        for (size_t j = 0; j < reduceLanes; ++j) {
+            lanes[j] += static_cast<sum_t<V>>(get(i + j));
+        }
+    }
+    sum_t<V> total{};
+    for (; i < n; ++i) {
+        total += static_cast<sum_t<V>>(get(i));
+    }
+    for (const auto lane : lanes) {
+        total += lane;
+    }
+    return total;
+}
+
+// Returns the value of get(i) for i in [0, n) that is ordered first by before.
+template <typename V, typename Getter, typename Before>
+std::optional<V> selectKernel(size_t n, const Getter& get, const Before& before) {
+    checkReducible<V>();
+    if (n == 0) {
+        return std::nullopt;
+    }
+    std::array<V, reduceLanes> lanes;
+    lanes.fill(get(0));
+    size_t i = 0;
+    for (; i + reduceLanes <= n; i += reduceLanes) {
+        for (size_t j = 0; j < reduceLanes; ++j) {
+            // A select rather than a branch, which maps to a vector min or max instruction.
+            const V value = get(i + j);
+            lanes[j] = before(value, lanes[j]) ? value : lanes[j];
+        }
+    }
+    V result = lanes[0];
+    for (; i < n; ++i) {
+        const V value = get(i);
+        result = before(value, result) ? value : result;
+    }
+    for (const auto lane : lanes) {
+        result = before(lane, result) ? lane : result;
+    }
+    return result;
+}
+
+// Returns the indices i in [0, n) for which pred(get(i)) is true.
+template <typename Getter, typename Predicate>
+std::vector<size_t> filterKernel(size_t n, const Getter& get, Predicate& pred) {
+    std::vector<size_t> selected(n);
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        // Branchless: always write the index, only advancing past it if it matched.
+        selected[count] = i;
+        count += static_cast<bool>(pred(get(i)));
+    }
+    selected.resize(count);
+    return selected;
+}
+
+// Returns the I'th field of an element of a span of T, allowing const and non-const elements.
+template <size_t I, typename T>
+constexpr auto& rowField(T& row) {
+    return row.*std::get<I>(flatFields<std::remove_const_t<T>>).ptr;
+}
+
+// Compares a pair of field values, element-wise for C-style arrays.
+template <typename M>
+constexpr bool fieldEqual(const M& lhs, const M& rhs) {
+    if constexpr (std::is_array_v<M>) {
+        for (size_t i = 0; i < std::extent_v<M>; ++i) {
+            if (!fieldEqual(lhs[i], rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    } else if constexpr (std::is_class_v<M> && is_reflecxx_visitable_v<M>) {
+        return reflecxx::equalTo(lhs, rhs);
+    } else {
+        return lhs == rhs;
+    }
+}
+
+// ANDs the equality of each pair of values in lhs and rhs into out.
+template <typename V>
+void equalColumn(span<const V> lhs, span<const V> rhs, span<bool> out) {
+    for (size_t i = 0; i < out.size(); ++i) {
+        // Bitwise rather than logical and, to avoid a branch per value.
+        out[i] = out[i] & fieldEqual(lhs[i], rhs[i]);
+    }
+}
+
+template <typename T, size_t... Is>
+void equalColumns(const soa_vector<T>& lhs, const soa_vector<T>& rhs, span<bool> out, std::index_sequence<Is...>) {
+    (equalColumn(lhs.template column<Is>(), rhs.template column<Is>(), out), ...);
+}
+
+inline void checkSizes(size_t lhs, size_t rhs, size_t out) {
+    if (lhs != rhs || lhs != out) {
+        throw std::invalid_argument{"Sizes of compared ranges and output don't match."};
+    }
+}
+
+} // namespace detail
+
+template <typename V>
+auto sum(span<V> column) {
+    return detail::sumKernel<std::remove_const_t<V>>(column.size(), [&column](size_t i) { return column[i]; });
+}
+
+template <size_t I, typename T>
+auto sum(const soa_vector<T>& rows) {
+    return sum(rows.template column<I>());
+}
+
+template <size_t I, typename T>
+auto sum(span<T> rows) {
+    using V = typeAt<I, std::remove_const_t<T>>;
+    return detail::sumKernel<V>(rows.size(), [&rows](size_t i) { return detail::rowField<I>(rows[i]); });
+}
+
+template <typename V>
+auto min(span<V> column) {
+    return detail::selectKernel<std::remove_const_t<V>>(
+        column.size(), [&column](size_t i) { return column[i]; }, std::less<>{});
+}
+
+template <size_t I, typename T>
+auto min(const soa_vector<T>& rows) {
+    return min(rows.template column<I>());
+}
+
+template <size_t I, typename T>
+auto min(span<T> rows) {
+    using V = typeAt<I, std::remove_const_t<T>>;
+    return detail::selectKernel<V>(
+        rows.size(), [&rows](size_t i) { return detail::rowField<I>(rows[i]); }, std::less<>{});
+}
+
+template <typename V>
+auto max(span<V> column) {
+    return detail::selectKernel<std::remove_const_t<V>>(
+        column.size(), [&column](size_t i) { return column[i]; }, std::greater<>{});
+}
+
+template <size_t I, typename T>
+auto max(const soa_vector<T>& rows) {
+    return max(rows.template column<I>());
+}
+
+template <size_t I, typename T>
+auto max(span<T> rows) {
+    using V = typeAt<I, std::remove_const_t<T>>;
+    return detail::selectKernel<V>(
+        rows.size(), [&rows](size_t i) { return detail::rowField<I>(rows[i]); }, std::greater<>{});
+}
+
+template <typename V, typename Predicate>
+std::vector<size_t> filter(span<V> column, Predicate&& pred) {
+    return detail::filterKernel(
+        column.size(), [&column](size_t i) -> const auto& { return column[i]; }, pred);
+}
+
+template <size_t I, typename T, typename Predicate>
+std::vector<size_t> filter(const soa_vector<T>& rows, Predicate&& pred) {
+    return filter(rows.template column<I>(), pred);
+}
+
+template <size_t I, typename T, typename Predicate>
+std::vector<size_t> filter(span<T> rows, Predicate&& pred) {
+    return detail::filterKernel(
+        rows.size(), [&rows](size_t i) -> const auto& { return detail::rowField<I>(rows[i]); }, pred);
+}
+
+template <typename T>
+void equalTo(const soa_vector<T>& lhs, const soa_vector<T>& rhs, span<bool> out) {
+    detail::checkSizes(lhs.size(), rhs.size(), out.size());
+    // Column at a time, so that each pass streams through a pair of contiguous arrays.
+    std::fill(out.begin(), out.end(), true);
+    detail::equalColumns(lhs, rhs, out, std::make_index_sequence<fieldCount<T>()>{});
+}
+
+template <typename T>
+void equalTo(span<T> lhs, span<T> rhs, span<bool> out) {
+    detail::checkSizes(lhs.size(), rhs.size(), out.size());
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = equalTo(lhs[i], rhs[i]);
+    }
+}
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
@@ -0,0 +1,161 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+#include <reflecxx/detail/perfect_hash.hpp>
+#include <reflecxx/types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace reflecxx::detail {
+
+// Returned when there is no enumerator for a value.
+inline constexpr size_t npos = static_cast<size_t>(-1);
+
+// Smallest unsigned type able to hold the index of any of N enumerators, plus one. Tables store index + 1 so that a
+// zero initialized entry means "no enumerator".
+template <size_t N>
+using enum_index_t =
+    std::conditional_t<(N < UINT8_MAX), uint8_t, std::conditional_t<(N < UINT16_MAX), uint16_t, uint32_t>>;
+
+// The lowest and highest underlying values of an enum's enumerators.
+template <typename EnumType>
+constexpr auto makeEnumValueBounds() {
+    using Utype = std::underlying_type_t<EnumType>;
+    const auto& enumerators = MetaEnum<EnumType>::enumerators;
+    Utype lowest{};
+    Utype highest{};
+    for (size_t i = 0; i < enumerators.size(); ++i) {
+        if (i == 0 || enumerators[i].value < lowest) {
+            lowest = enumerators[i].value;
+        }
+        if (i == 0 || enumerators[i].value > highest) {
+            highest = enumerators[i].value;
+        }
+    }
+    return std::make_pair(lowest, highest);
+}
+template <typename EnumType>
+inline constexpr auto enumValueBounds = makeEnumValueBounds<EnumType>();
+
+// Distance of value above the lowest enumerator value. Computed in unsigned arithmetic so that it can't overflow for
+// signed underlying types; values below the lowest enumerator wrap around to very large offsets.
+template <typename EnumType>
+constexpr uintmax_t enumValueOffset(std::underlying_type_t<EnumType> value) {
+    return static_cast<uintmax_t>(value) - static_cast<uintmax_t>(enumValueBounds<EnumType>.first);
+}
+
+// Number of distinct enumerator values, i.e. of enumerators that aren't aliases of an earlier one.
+template <typename EnumType>
+constexpr size_t countEnumValues() {
+    const auto& enumerators = MetaEnum<EnumType>::enumerators;
+    size_t count = 0;
+    for (size_t i = 0; i < enumerators.size(); ++i) {
+        bool alias = false;
+        for (size_t j = 0; j < i && !alias; ++j) {
+            alias = enumerators[j].value == enumerators[i].value;
+        }
+        count += alias ? 0 : 1;
+    }
+    return count;
+}
+template <typename EnumType>
+inline constexpr size_t enumValueCount = countEnumValues<EnumType>();
+
+// Enums whose values are contiguous or nearly so (at least half of the value range is used) are indexed with a direct
+// lookup table. Sparse enums use a perfect hash of their distinct values instead.
+template <typename EnumType>
+inline constexpr bool isDenseEnum = MetaEnum<EnumType>::enumerators.size() > 0 &&
+                                    enumValueOffset<EnumType>(enumValueBounds<EnumType>.second) <
+                                        2 * MetaEnum<EnumType>::enumerators.size();
+
+// The splitmix64 finalizer is a bijection, so distinct values always have distinct hashes.
+template <typename Utype>
+constexpr uint64_t hashEnumValue(Utype value) {
+    return mixHash(static_cast<uint64_t>(value));
+}
+
+template <typename Utype, size_t N, size_t Enumerators>
+struct HashedEnumValues {
+    PerfectHash<N> hash{};
+    // The distinct values, and the index of the first enumerator with each, plus one, in the order of the hashed keys.
+    std::array<Utype, N> values{};
+    std::array<enum_index_t<Enumerators>, N> indices{};
+};
+
+// Builds the table mapping underlying values to enumerator indices. When several enumerators share a value, the first
+// one declared wins, matching a linear search.
+template <typename EnumType>
+constexpr auto makeEnumValueTable() {
+    constexpr auto& enumerators = MetaEnum<EnumType>::enumerators;
+    constexpr auto n = enumerators.size();
+    using Index = enum_index_t<n>;
+
+    if constexpr (isDenseEnum<EnumType>) {
+        constexpr auto size = enumValueOffset<EnumType>(enumValueBounds<EnumType>.second) + 1;
+        std::array<Index, size> table{};
+        for (size_t i = n; i-- > 0;) {
+            table[enumValueOffset<EnumType>(enumerators[i].value)] = static_cast<Index>(i + 1);
+        }
+        return table;
+    } else {
+        constexpr auto m = enumValueCount<EnumType>;
+        HashedEnumValues<std::underlying_type_t<EnumType>, m, n> table{};
+        std::array<uint64_t, m> hashes{};
+        size_t k = 0;
+        for (size_t i = 0; i < n; ++i) {
+            bool alias = false;
+            for (size_t j = 0; j < k && !alias; ++j) {
+                alias = table.values[j] == enumerators[i].value;
+            }
+            if (!alias) {
+                table.values[k] = enumerators[i].value;
+                table.indices[k] = static_cast<Index>(i + 1);
+                hashes[k] = hashEnumValue(enumerators[i].value);
+                ++k;
+            }
+        }
+        table.hash = makePerfectHash(hashes);
+        return table;
+    }
+}
+template <typename EnumType>
+inline constexpr auto enumValueTable = makeEnumValueTable<EnumType>();
+
+// Returns the index into MetaEnum<EnumType>::enumerators of the first enumerator with the given value, or npos.
+template <typename EnumType>
+constexpr size_t enumValueIndex(std::underlying_type_t<EnumType> value) noexcept {
+    constexpr auto& table = enumValueTable<EnumType>;
+    if constexpr (isDenseEnum<EnumType>) {
+        const auto offset = enumValueOffset<EnumType>(value);
+        // An empty entry wraps around to npos.
+        return offset < table.size() ? static_cast<size_t>(table[offset]) - 1 : npos;
+    } else if constexpr (enumValueCount<EnumType> == 0) {
+        return npos;
+    } else {
+        const auto k = table.hash.findHash(hashEnumValue(value));
+        return table.values[k] == value ? static_cast<size_t>(table.indices[k]) - 1 : npos;
+    }
+}
+
+// Whether each index into MetaEnum<EnumType>::enumerators is the one enumValueIndex returns for its value, i.e. false
+// only for aliases of an earlier enumerator.
+template <typename EnumType>
+constexpr auto makeEnumIndexUsed() {
+    constexpr auto& enumerators = MetaEnum<EnumType>::enumerators;
+    std::array<bool, enumerators.size()> used{};
+    for (size_t i = 0; i < enumerators.size(); ++i) {
+        used[i] = enumValueIndex<EnumType>(enumerators[i].value) == i;
+    }
+    return used;
+}
+template <typename EnumType>
+inline constexpr auto enumIndexUsed = makeEnumIndexUsed<EnumType>();
+
+} // namespace reflecxx::detail
@@ -0,0 +1,146 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace reflecxx::detail {
+
+// 64 bit FNV-1a. Cheap to compute and constexpr friendly; only used for building lookup tables, not security.
+constexpr uint64_t fnv1a(std::string_view str) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Finalizer from splitmix64. Mixing the seed into the already computed string hash gives a family of independent hash
+// functions, so that the string only ever has to be walked once per lookup.
+constexpr uint64_t mixHash(uint64_t hash, uint64_t seed = 0) {
+    hash ^= seed * 0x9e3779b97f4a7c15ull;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+}
+
+// Minimal perfect hash over a fixed set of N distinct keys, built at compile time using the "hash and displace"
+// technique. Keys are strings, or the 64 bit hashes of keys of other types. Keys are hashed into N buckets, then buckets
+// are processed largest first, searching for a seed per bucket that places all of the bucket's keys into free slots.
+// Buckets holding a single key are placed directly into whatever slots remain.
+// Lookups always yield an index in [0, N), including for keys that are not part of the set, so the caller must do a
+// final comparison against the key at the returned index.
+template <size_t N>
+struct PerfectHash {
+    // Seed per bucket, or -(slot + 1) for buckets holding a single key.
+    std::array<int32_t, N> displacements{};
+    // Index of the original key occupying each slot.
+    std::array<size_t, N> slots{};
+
+    // Returns the index of the only key that could be equal to key.
+    constexpr size_t find(std::string_view key) const { return findHash(fnv1a(key)); }
+
+    // As above, for the key whose 64 bit hash is given.
+    constexpr size_t findHash(uint64_t hash) const {
+        static_assert(N > 0, "Lookup in an empty set!");
+        const auto d = displacements[mixHash(hash) % N];
+        if (d < 0) {
+            return slots[static_cast<size_t>(-(d + 1))];
+        }
+        return slots[mixHash(hash, static_cast<uint64_t>(d)) % N];
+    }
+};
+
+// Builds the perfect hash of keys with the given 64 bit hashes, which must be distinct.
+template <size_t N>
+constexpr PerfectHash<N> makePerfectHash(const std::array<uint64_t, N>& hashes) {
+    PerfectHash<N> table{};
+    if constexpr (N > 0) {
+        std::array<size_t, N> bucketSizes{};
+        for (size_t i = 0; i < N; ++i) {
+            bucketSizes[mixHash(hashes[i]) % N]++;
+        }
+
+        // Counting sort of the keys by bucket, so that the keys of each bucket are contiguous in bucketKeys.
+        std::array<size_t, N + 1> bucketStart{};
+        size_t maxBucketSize = 0;
+        for (size_t b = 0; b < N; ++b) {
+            bucketStart[b + 1] = bucketStart[b] + bucketSizes[b];
+            maxBucketSize = bucketSizes[b] > maxBucketSize ? bucketSizes[b] : maxBucketSize;
+        }
+        std::array<size_t, N> bucketKeys{};
+        std::array<size_t, N> bucketFill{};
+        for (size_t i = 0; i < N; ++i) {
+            const auto b = mixHash(hashes[i]) % N;
+            bucketKeys[bucketStart[b] + bucketFill[b]++] = i;
+        }
+
+        std::array<bool, N> occupied{};
+        std::array<size_t, N> candidate{};
+        for (auto size = maxBucketSize; size > 1; --size) {
+            for (size_t b = 0; b < N; ++b) {
+                if (bucketSizes[b] != size) {
+                    continue;
+                }
+                for (size_t k = 1; k < size; ++k) {
+                    for (size_t j = 0; j < k; ++j) {
+                        if (hashes[bucketKeys[bucketStart[b] + j]] == hashes[bucketKeys[bucketStart[b] + k]]) {
+                            // No seed can separate these. Will cause compilation error in constexpr context.
+                            throw std::logic_error{"Unable to build perfect hash, keys are not unique."};
+                        }
+                    }
+                }
+                for (int32_t d = 1;; ++d) {
+                    bool placed = true;
+                    for (size_t k = 0; k < size && placed; ++k) {
+                        candidate[k] = mixHash(hashes[bucketKeys[bucketStart[b] + k]], static_cast<uint64_t>(d)) % N;
+                        placed = !occupied[candidate[k]];
+                        for (size_t j = 0; j < k && placed; ++j) {
+                            placed = candidate[j] != candidate[k];
+                        }
+                    }
+                    if (placed) {
+                        for (size_t k = 0; k < size; ++k) {
+                            occupied[candidate[k]] = true;
+                            table.slots[candidate[k]] = bucketKeys[bucketStart[b] + k];
+                        }
+                        table.displacements[b] = d;
+                        break;
+                    }
+                }
+            }
+        }
+
+        size_t freeSlot = 0;
+        for (size_t b = 0; b < N; ++b) {
+            if (bucketSizes[b] != 1) {
+                continue;
+            }
+            while (occupied[freeSlot]) {
+                ++freeSlot;
+            }
+            occupied[freeSlot] = true;
+            table.slots[freeSlot] = bucketKeys[bucketStart[b]];
+            table.displacements[b] = -static_cast<int32_t>(freeSlot) - 1;
+        }
+    }
+    return table;
+}
+
+template <size_t N>
+constexpr PerfectHash<N> makePerfectHash(const std::array<std::string_view, N>& keys) {
+    std::array<uint64_t, N> hashes{};
+    for (size_t i = 0; i < N; ++i) {
+        hashes[i] = fnv1a(keys[i]);
+    }
+    return makePerfectHash(hashes);
+}
+
+} // namespace reflecxx::detail
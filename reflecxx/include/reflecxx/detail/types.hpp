@@ -4,6 +4,19 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
 namespace reflecxx::detail {
 
 // The following looks rather obtuse, but it's a neat trick that enables us to enforce that MetaStruct must be
@@ -33,4 +46,61 @@ struct remove_cvref {
 template <typename T>
 using remove_cvref_t = typename remove_cvref<T>::type;
 
+template <typename T>
+struct is_std_array : std::false_type {};
+template <typename T, size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+template <typename T>
+struct is_optional : std::false_type {};
+template <typename T>
+struct is_optional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+struct is_string : std::false_type {};
+template <typename Traits, typename Allocator>
+struct is_string<std::basic_string<char, Traits, Allocator>> : std::true_type {};
+
+template <typename T, typename = void>
+struct is_iterable : std::false_type {};
+template <typename T>
+struct is_iterable<T, std::void_t<decltype(std::begin(std::declval<T&>())), decltype(std::end(std::declval<T&>()))>>
+: std::true_type {};
+
+template <typename T, typename = void>
+struct is_emplace_back_container : std::false_type {};
+template <typename T>
+struct is_emplace_back_container<T, std::void_t<decltype(std::declval<T&>().emplace_back())>> : std::true_type {};
+
+// Assigns src to dst, element-wise for C-style arrays.
+template <typename M, typename S>
+void assignField(M& dst, S&& src) {
+    if constexpr (std::is_array_v<M>) {
+        for (size_t i = 0; i < std::extent_v<M>; ++i) {
+            assignField(dst[i], std::forward<S>(src)[i]);
+        }
+    } else {
+        dst = std::forward<S>(src);
+    }
+}
+
+#if defined(__cpp_lib_memory_resource)
+// True for allocator aware containers using a polymorphic allocator, such as std::pmr::string and std::pmr::vector.
+template <typename T, typename = void>
+struct is_pmr_container : std::false_type {};
+template <typename T>
+struct is_pmr_container<T, std::void_t<typename T::allocator_type, typename T::value_type>>
+: std::is_same<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::value_type>> {};
+
+// Makes the container value allocate from resource, discarding its contents if it doesn't already.
+template <typename T>
+void useResource(T& value, std::pmr::memory_resource* resource) {
+    if (value.get_allocator().resource() != resource) {
+        // Assignment never propagates a polymorphic allocator, so the container is recreated in place instead.
+        value.~T();
+        ::new (static_cast<void*>(&value)) T(typename T::allocator_type{resource});
+    }
+}
+#endif
+
 } // namespace reflecxx::detail
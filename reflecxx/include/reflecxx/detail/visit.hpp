@@ -13,60 +13,79 @@
 #include <array>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace reflecxx {
 
+template <typename T, typename V>
+constexpr void visit(T&& instance, V&& visitor);
 template <typename T, typename V>
 constexpr void visit(V&& visitor);
 template <typename T, typename V>
+constexpr auto visitAccummulate(T&& instance, V&& visitor);
+template <typename T, typename V>
 constexpr auto visitAccummulate(V&& visitor);
 
 namespace detail {
 
-// When appending to a tuple, if the item being appended is itself a tuple, to match the semantics of the non-tuple case
-// most of the time the desired result is a nested tuple, e.g. appending tuple<int, double> to tuple<char, bool> would
-// give tuple<char, bool, tuple<int, double>>, similar to how appending a plain int would result in
-// tuple<char, bool, int>. However sometimes unnesting is desired, e.g. resulting in tuple<char, bool, int, double>.
-template <bool Unnest = false, typename... Ts, typename T>
-constexpr auto tupleAppend(std::tuple<Ts...> t, T m) {
-    return std::tuple_cat(std::move(t), std::make_tuple(std::move(m)));
-}
-template <bool Unnest, typename... Ts, typename... Tp, typename = std::enable_if_t<Unnest>>
-constexpr auto tupleAppend(std::tuple<Ts...> t1, std::tuple<Tp...> t2) {
-    return std::tuple_cat(std::move(t1), std::move(t2));
-}
-
 // Apply a visitor to each element of tuple, discarding return values.
 template <typename... Ts, typename V>
 constexpr void forEach(const std::tuple<Ts...>& t, V&& visitor) {
     std::apply([&visitor](const auto&... tupleElems) { (visitor(tupleElems), ...); }, t);
 }
 
+// Concatenates head with each of the tuples in nested, e.g. tuple<char> and tuple<tuple<int>, tuple<bool, double>> give
+// tuple<char, int, bool, double>, in a single tuple_cat.
+template <typename... Ts, typename... Ns>
+constexpr auto tupleFlatten(std::tuple<Ts...> head, std::tuple<Ns...> nested) {
+    return std::apply([&head](auto&... ns) { return std::tuple_cat(std::move(head), std::move(ns)...); }, nested);
+}
+
+template <typename T, typename = void>
+struct has_private_fields : std::false_type {};
+template <typename T>
+struct has_private_fields<T, std::void_t<decltype(MetaStruct<T>::privateFields)>> : std::true_type {};
+
+template <typename T>
+constexpr auto makeOwnFields() {
+    if constexpr (has_private_fields<T>::value) {
+        return std::tuple_cat(MetaStruct<T>::publicFields, MetaStruct<T>::privateFields);
+    } else {
+        return MetaStruct<T>::publicFields;
+    }
+}
+
+// Tuple of the ClassMembers of the fields declared by T itself: the public ones, followed by the private and protected
+// ones if T declares REFLECXX_FRIEND.
+template <typename T>
+inline constexpr auto ownFields = makeOwnFields<T>();
+
 // Apply a visitor to each element of tuple, accumulating return values in a tuple.
 // It would have been really nice to implement this as
 //     return std::apply([&visitor](const auto&... tupleElems) { return std::make_tuple(visitor(tupleElems)...); }, t);
 // however that doesn't guarantee the order of evaluation of the args to std::make_tuple, i.e. that the visitor will
-// execute in order of the tuple elements.
-// Instead, use a recursive call, chaining the tuple of previous results into the next call.
-template <bool Unnest = false, size_t I = 0, typename... Tp, typename V, typename... Ts>
-constexpr auto forEach(const std::tuple<Tp...>& t, V&& visitor, std::tuple<Ts...> prevResults) {
-    const auto results = tupleAppend<Unnest>(std::move(prevResults), visitor(std::get<I>(t)));
-    if constexpr (I + 1 != sizeof...(Tp)) {
-        return forEach<Unnest, I + 1>(t, visitor, std::move(results));
+// execute in order of the tuple elements. The elements of a braced initializer list are evaluated strictly in order
+// though, so the result tuple is list-initialized from a single pack expansion instead, without any recursion.
+// If the results are themselves tuples, usually a tuple of tuples is desired, matching the non-tuple case. With Unnest
+// they are concatenated instead, e.g. giving tuple<char, bool, int, double> rather than
+// tuple<tuple<char, bool>, tuple<int, double>>.
+template <bool Unnest = false, typename... Ts, typename V>
+constexpr auto forEachAccum(const std::tuple<Ts...>& t, V&& visitor) {
+    auto results = std::apply(
+        [&visitor](const auto&... tupleElems) {
+            return std::tuple<std::decay_t<std::invoke_result_t<V&, const Ts&>>...>{visitor(tupleElems)...};
+        },
+        t);
+    if constexpr (Unnest) {
+        return tupleFlatten(std::tuple<>{}, std::move(results));
     } else {
         return results;
     }
 }
-// Handle the empty tuple case.
-template <bool = false, size_t = 0, typename V, typename... Ts>
-constexpr auto forEach(const std::tuple<>&, V&&, std::tuple<Ts...> prevResults) {
-    return prevResults;
-}
-// Wrapper so that empty tuples don't have to be provided for the starting case.
-template <bool Unnest = false, typename... Ts, typename V>
-constexpr auto forEachAccum(const std::tuple<Ts...>& t, V&& visitor) {
-    return forEach<Unnest>(t, std::forward<V>(visitor), std::tuple<>{});
-}
+
+// Type B with the same const-ness as (the possibly reference type) T.
+template <typename B, typename T>
+using match_const_t = std::conditional_t<std::is_const_v<std::remove_reference_t<T>>, const B, B>;
 
 // Functor that wraps a visitor to perform binding between an instance and a ClassMember.
 template <typename T, typename V>
@@ -86,7 +105,7 @@ struct BaseClassMemberVisitor {
     template <typename B>
     constexpr void operator()(type_tag<B>) {
         // Fully recurse to handle multiple levels of inheritance and multiple base classes.
-        visit(static_cast<B&>(instance), visitor);
+        visit(static_cast<match_const_t<B, T>&>(instance), visitor);
     }
 
     T& instance;
@@ -99,7 +118,7 @@ struct BaseClassMemberChainVisitor {
     template <typename B>
     constexpr auto operator()(type_tag<B>) {
         // Fully recurse to handle multiple levels of inheritance and multiple base classes.
-        return visitAccum(static_cast<B&>(instance), visitor);
+        return visitAccummulate(static_cast<match_const_t<B, T>&>(instance), visitor);
     }
 
     T& instance;
@@ -0,0 +1,263 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/detail/enum_index.hpp>
+#include <reflecxx/enum_visitor.hpp>
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Containers keyed by the enumerators of a reflecxx visitable enum, stored in a std::array with one slot per
+// enumerator, in declaration order. A key is turned into its slot by reflecxx::enumIndex, in constant time: a direct
+// table lookup for enums whose values are dense, whatever their lowest value, or a perfect hash of the values of sparse
+// enums. There are no collisions to resolve and no allocations, unlike for std::unordered_map<E, V>.
+//
+// Aliases share the slot of the first enumerator declared with their value, so their own slots are never used, and
+// iteration visits each value once.
+
+namespace reflecxx {
+
+// Maps every enumerator of E to a value of V. Every key is always present, initially mapped to a value initialized V.
+template <typename E, typename V>
+class enum_map {
+    template <bool Const>
+    class basic_iterator;
+
+ public:
+    using key_type = E;
+    using mapped_type = V;
+    using size_type = size_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    constexpr enum_map() = default;
+    // Throws if a key isn't an enumerator. Later entries for the same key overwrite earlier ones.
+    constexpr enum_map(std::initializer_list<std::pair<E, V>> entries) {
+        for (const auto& [key, value] : entries) {
+            at(key) = value;
+        }
+    }
+
+    // Returns the value of key, which must be an enumerator of E.
+    constexpr V& operator[](E key) noexcept { return values[slot(key)]; }
+    constexpr const V& operator[](E key) const noexcept { return values[slot(key)]; }
+    // As above, but throws if key isn't an enumerator of E.
+    constexpr V& at(E key) { return values[enumIndex(key)]; }
+    constexpr const V& at(E key) const { return values[enumIndex(key)]; }
+
+    // The number of keys, i.e. of distinct enumerator values.
+    static constexpr size_t size() noexcept { return detail::enumValueCount<E>; }
+    static constexpr bool empty() noexcept { return size() == 0; }
+
+    // Sets every value to value.
+    constexpr void fill(const V& value) {
+        for (auto& v : values) {
+            v = value;
+        }
+    }
+
+    // Iteration yields std::pair<E, V&> in declaration order of the enumerators, e.g.
+    //   for (auto [key, value] : map) {...}
+    constexpr iterator begin() noexcept { return iterator{values.data(), 0}; }
+    constexpr iterator end() noexcept { return iterator{values.data(), values.size()}; }
+    constexpr const_iterator begin() const noexcept { return const_iterator{values.data(), 0}; }
+    constexpr const_iterator end() const noexcept { return const_iterator{values.data(), values.size()}; }
+
+    friend constexpr bool operator==(const enum_map& lhs, const enum_map& rhs) {
+        for (size_t i = 0; i < lhs.values.size(); ++i) {
+            if (detail::enumIndexUsed<E>[i] && !(lhs.values[i] == rhs.values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    friend constexpr bool operator!=(const enum_map& lhs, const enum_map& rhs) { return !(lhs == rhs); }
+
+ private:
+    static constexpr size_t slot(E key) noexcept {
+        return detail::enumValueIndex<E>(static_cast<std::underlying_type_t<E>>(key));
+    }
+
+    std::array<V, enumSize<E>()> values{};
+};
+
+template <typename E, typename V>
+template <bool Const>
+class enum_map<E, V>::basic_iterator {
+    using Value = std::conditional_t<Const, const V, V>;
+
+ public:
+    // Dereferencing returns a pair by value, so this is only an input iterator.
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::pair<E, Value&>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    constexpr basic_iterator() noexcept = default;
+    constexpr basic_iterator(Value* values, size_t index) noexcept
+    : values(values)
+    , index(index) {
+        skipUnused();
+    }
+
+    constexpr value_type operator*() const noexcept {
+        return {MetaEnum<E>::enumerators[index].enumerator, values[index]};
+    }
+    constexpr basic_iterator& operator++() noexcept {
+        ++index;
+        skipUnused();
+        return *this;
+    }
+    constexpr basic_iterator operator++(int) noexcept {
+        auto it = *this;
+        ++*this;
+        return it;
+    }
+    constexpr bool operator==(const basic_iterator& rhs) const noexcept { return index == rhs.index; }
+    constexpr bool operator!=(const basic_iterator& rhs) const noexcept { return index != rhs.index; }
+
+ private:
+    constexpr void skipUnused() noexcept {
+        while (index < enumSize<E>() && !detail::enumIndexUsed<E>[index]) {
+            ++index;
+        }
+    }
+
+    Value* values{};
+    size_t index{};
+};
+
+// Set of enumerators of E.
+template <typename E>
+class enum_set {
+ public:
+    using key_type = E;
+    using value_type = E;
+    using size_type = size_t;
+
+    // Iterates over the enumerators in the set, in declaration order.
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = E;
+
+        constexpr iterator() noexcept = default;
+        constexpr iterator(const bool* present, size_t index) noexcept
+        : present(present)
+        , index(index) {
+            skipAbsent();
+        }
+
+        constexpr E operator*() const noexcept { return MetaEnum<E>::enumerators[index].enumerator; }
+        constexpr iterator& operator++() noexcept {
+            ++index;
+            skipAbsent();
+            return *this;
+        }
+        constexpr iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+        constexpr bool operator==(const iterator& rhs) const noexcept { return index == rhs.index; }
+        constexpr bool operator!=(const iterator& rhs) const noexcept { return index != rhs.index; }
+
+     private:
+        constexpr void skipAbsent() noexcept {
+            while (index < enumSize<E>() && !present[index]) {
+                ++index;
+            }
+        }
+
+        const bool* present{};
+        size_t index{};
+    };
+    using const_iterator = iterator;
+
+    constexpr enum_set() noexcept = default;
+    // Throws if a value isn't an enumerator.
+    constexpr enum_set(std::initializer_list<E> es) {
+        for (const auto e : es) {
+            insert(e);
+        }
+    }
+
+    // Returns true if e is in the set. Values without an enumerator never are.
+    constexpr bool contains(E e) const noexcept {
+        const auto i = slot(e);
+        return i != detail::npos && present[i];
+    }
+    constexpr size_t count(E e) const noexcept { return contains(e) ? 1 : 0; }
+
+    // Adds e, returning true if it wasn't in the set already. Throws if e isn't an enumerator.
+    constexpr bool insert(E e) {
+        const auto i = enumIndex(e);
+        const bool inserted = !present[i];
+        present[i] = true;
+        return inserted;
+    }
+    // Removes e, returning true if it was in the set.
+    constexpr bool erase(E e) noexcept {
+        const auto i = slot(e);
+        if (i == detail::npos || !present[i]) {
+            return false;
+        }
+        present[i] = false;
+        return true;
+    }
+    constexpr void clear() noexcept {
+        for (auto& p : present) {
+            p = false;
+        }
+    }
+
+    constexpr size_t size() const noexcept {
+        size_t n = 0;
+        for (const bool p : present) {
+            n += p ? 1 : 0;
+        }
+        return n;
+    }
+    constexpr bool empty() const noexcept { return size() == 0; }
+    // The number of distinct enumerator values.
+    static constexpr size_t max_size() noexcept { return detail::enumValueCount<E>; }
+
+    constexpr iterator begin() const noexcept { return iterator{present.data(), 0}; }
+    constexpr iterator end() const noexcept { return iterator{present.data(), present.size()}; }
+
+    friend constexpr bool operator==(const enum_set& lhs, const enum_set& rhs) noexcept {
+        for (size_t i = 0; i < lhs.present.size(); ++i) {
+            if (lhs.present[i] != rhs.present[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    friend constexpr bool operator!=(const enum_set& lhs, const enum_set& rhs) noexcept { return !(lhs == rhs); }
+
+ private:
+    static constexpr size_t slot(E e) noexcept {
+        return detail::enumValueIndex<E>(static_cast<std::underlying_type_t<E>>(e));
+    }
+
+    std::array<bool, enumSize<E>()> present{};
+};
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
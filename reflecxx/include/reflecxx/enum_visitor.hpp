@@ -10,6 +10,8 @@
 
 #include <array>
 #include <cstddef>
+#include <optional>
+#include <string_view>
 #include <type_traits>
 
 namespace reflecxx {
@@ -22,14 +24,22 @@ constexpr std::string_view getName();
 template <typename EnumType>
 constexpr size_t enumSize();
 
-// Returns the name of the enumerator as string.
+// Returns the name of the enumerator as string. Throws if the value doesn't correspond to an enumerator.
 template <typename EnumType>
 constexpr std::string_view enumName(EnumType enumerator);
 
-// Converts a name to a matching enumerator.
+// Returns the name of the enumerator as string, or an empty view if the value doesn't correspond to an enumerator.
+template <typename EnumType>
+constexpr std::string_view tryEnumName(EnumType enumerator) noexcept;
+
+// Converts a name to a matching enumerator. Throws if there is no enumerator with that name.
 template <typename EnumType>
 constexpr EnumType fromName(std::string_view enumeratorName);
 
+// Converts a name to a matching enumerator, or std::nullopt if there is no enumerator with that name.
+template <typename EnumType>
+constexpr std::optional<EnumType> tryFromName(std::string_view enumeratorName) noexcept;
+
 // Returns an array containing the names of all enumerators. The views never expire.
 template <typename EnumType>
 constexpr auto enumNames() -> std::array<std::string_view, enumSize<EnumType>()>;
@@ -43,6 +53,15 @@ constexpr auto enumerators() -> std::array<EnumType, enumSize<EnumType>()>;
 template <typename EnumType>
 constexpr bool enumContains(std::underlying_type_t<EnumType> targetValue);
 
+// Returns the position of the enumerator in MetaEnum<EnumType>::enumerators, in constant time. Aliases share the index
+// of the first enumerator declared with their value. Throws if the value doesn't correspond to an enumerator.
+template <typename EnumType>
+constexpr size_t enumIndex(EnumType enumerator);
+
+// As above, but returns std::nullopt if the value doesn't correspond to an enumerator.
+template <typename EnumType>
+constexpr std::optional<size_t> tryEnumIndex(EnumType enumerator) noexcept;
+
 } // namespace reflecxx
 
 #include "impl/enum_visitor_impl.hpp"
@@ -0,0 +1,351 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+#include <reflecxx/enum_visitor.hpp>
+#include <reflecxx/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#if __has_include(<bit>)
+#include <bit>
+#endif
+
+// Sets of bit flags of a reflecxx visitable enum.
+// reflecxx::flags<E> holds any combination of the enumerators of E, whose values are bit masks, e.g.
+//   enum class Permission : uint8_t { Read = 1, Write = 2, Execute = 4, ReadWrite = Read | Write } REFLECXX_T;
+// in a single integer, so that membership tests and set operations are bit operations, and iterating visits only the
+// bits that are set. A set is formatted as the names of its flags separated by '|', e.g. "Read|Execute", using the
+// names of the single bit enumerators. Parsing accepts any enumerator name, including those of several bits, such as
+// "ReadWrite". Set bits without an enumerator are formatted, and parsed, as a decimal number, e.g. "Read|64".
+// reflecxx::flags is supported by the JSON reader and writer, the nlohmann JSON visitors, and binary serialization.
+//
+// The class itself doesn't depend on generated code, so it can be used as the type of a field of an annotated type.
+
+namespace reflecxx {
+
+namespace detail {
+
+// Number of trailing zero bits of a non-zero value.
+template <typename T>
+constexpr int countTrailingZeros(T value) noexcept {
+#if defined(__cpp_lib_bitops)
+    return std::countr_zero(value);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(static_cast<unsigned long long>(value));
+#else
+    int n = 0;
+    for (; (value & T{1}) == 0; value >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Number of set bits of value.
+template <typename T>
+constexpr int popCount(T value) noexcept {
+#if defined(__cpp_lib_bitops)
+    return std::popcount(value);
+#elif defined(__GNUC__)
+    return __builtin_popcountll(static_cast<unsigned long long>(value));
+#else
+    int n = 0;
+    for (; value != 0; value &= value - 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+} // namespace detail
+
+template <typename E>
+class flags {
+    static_assert(std::is_enum_v<E>, "flags requires an enum type!");
+
+ public:
+    using enum_type = E;
+    using bits_type = std::make_unsigned_t<std::underlying_type_t<E>>;
+
+    // Iterates over the set bits, from lowest to highest, as values of E.
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = E;
+
+        constexpr iterator() noexcept = default;
+        constexpr explicit iterator(bits_type bits) noexcept
+        : remaining(bits) {}
+
+        constexpr E operator*() const noexcept { return static_cast<E>(remaining & (~remaining + 1)); }
+        constexpr iterator& operator++() noexcept {
+            // Clears the lowest set bit.
+            remaining &= remaining - 1;
+            return *this;
+        }
+        constexpr iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+        constexpr bool operator==(const iterator& rhs) const noexcept { return remaining == rhs.remaining; }
+        constexpr bool operator!=(const iterator& rhs) const noexcept { return remaining != rhs.remaining; }
+
+     private:
+        bits_type remaining{};
+    };
+
+    constexpr flags() noexcept = default;
+    constexpr flags(E e) noexcept
+    : value(static_cast<bits_type>(e)) {}
+    constexpr flags(std::initializer_list<E> es) noexcept {
+        for (const auto e : es) {
+            value |= static_cast<bits_type>(e);
+        }
+    }
+
+    static constexpr flags fromBits(bits_type bits) noexcept {
+        flags f;
+        f.value = bits;
+        return f;
+    }
+    // The set of every bit of every enumerator of E. Requires E to be reflecxx visitable.
+    static constexpr flags all() noexcept {
+        bits_type bits{};
+        for (const auto& e : MetaEnum<E>::enumerators) {
+            bits |= static_cast<bits_type>(e.value);
+        }
+        return fromBits(bits);
+    }
+
+    constexpr bits_type bits() const noexcept { return value; }
+
+    // Returns true if every bit of f is set.
+    constexpr bool test(flags f) const noexcept { return (value & f.value) == f.value; }
+    constexpr bool any() const noexcept { return value != 0; }
+    constexpr bool none() const noexcept { return value == 0; }
+    constexpr explicit operator bool() const noexcept { return any(); }
+    // Returns the number of set bits.
+    constexpr size_t count() const noexcept { return static_cast<size_t>(detail::popCount(value)); }
+
+    constexpr flags& set(flags f) noexcept {
+        value |= f.value;
+        return *this;
+    }
+    constexpr flags& reset(flags f) noexcept {
+        value &= ~f.value;
+        return *this;
+    }
+    constexpr flags& flip(flags f) noexcept {
+        value ^= f.value;
+        return *this;
+    }
+    constexpr flags& clear() noexcept {
+        value = 0;
+        return *this;
+    }
+
+    constexpr iterator begin() const noexcept { return iterator{value}; }
+    constexpr iterator end() const noexcept { return iterator{}; }
+
+    constexpr flags& operator|=(flags f) noexcept { return set(f); }
+    constexpr flags& operator&=(flags f) noexcept {
+        value &= f.value;
+        return *this;
+    }
+    constexpr flags& operator^=(flags f) noexcept { return flip(f); }
+
+    friend constexpr flags operator|(flags lhs, flags rhs) noexcept { return lhs |= rhs; }
+    friend constexpr flags operator&(flags lhs, flags rhs) noexcept { return lhs &= rhs; }
+    friend constexpr flags operator^(flags lhs, flags rhs) noexcept { return lhs ^= rhs; }
+    // The complement within all(), so that no bits without an enumerator are set.
+    friend constexpr flags operator~(flags f) noexcept { return fromBits(~f.value & all().value); }
+    friend constexpr bool operator==(flags lhs, flags rhs) noexcept { return lhs.value == rhs.value; }
+    friend constexpr bool operator!=(flags lhs, flags rhs) noexcept { return lhs.value != rhs.value; }
+
+ private:
+    bits_type value{};
+};
+
+namespace detail {
+
+template <typename T>
+struct is_flags : std::false_type {};
+template <typename E>
+struct is_flags<flags<E>> : std::true_type {};
+
+} // namespace detail
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+// Writes the flags set in f as the names of their enumerators separated by '|', to out. Returns the output iterator one
+// past the last character written. Nothing is written if no flags are set.
+template <typename E, typename OutputIt>
+OutputIt writeFlags(flags<E> f, OutputIt out);
+
+// Returns the flags set in f as the names of their enumerators separated by '|'.
+template <typename E>
+std::string flagsToString(flags<E> f);
+
+// Parses the names of enumerators of E, or decimal numbers, separated by '|'. Returns std::nullopt if any of them isn't
+// the name of an enumerator or a number.
+template <typename E>
+constexpr std::optional<flags<E>> tryFlagsFromString(std::string_view str) noexcept;
+
+// As above, but throws std::runtime_error if str can't be parsed, which is a compilation error in a constant
+// expression.
+template <typename E>
+constexpr flags<E> flagsFromString(std::string_view str);
+
+namespace detail {
+
+// The name of the first enumerator of E whose value is each single bit, or an empty view if there is none.
+template <typename E>
+constexpr auto makeFlagNames() {
+    using Bits = typename flags<E>::bits_type;
+    std::array<std::string_view, std::numeric_limits<Bits>::digits> names{};
+    for (size_t i = MetaEnum<E>::enumerators.size(); i-- > 0;) {
+        const auto& e = MetaEnum<E>::enumerators[i];
+        const auto bits = static_cast<Bits>(e.value);
+        if (bits != 0 && (bits & (bits - 1)) == 0) {
+            names[countTrailingZeros(bits)] = e.name;
+        }
+    }
+    return names;
+}
+template <typename E>
+inline constexpr auto flagNames = makeFlagNames<E>();
+
+constexpr std::string_view trimSpaces(std::string_view str) {
+    while (!str.empty() && str.front() == ' ') {
+        str.remove_prefix(1);
+    }
+    while (!str.empty() && str.back() == ' ') {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+// Parses a decimal number of bits, returning std::nullopt if str isn't one or is out of range.
+template <typename Bits>
+constexpr std::optional<Bits> parseFlagBits(std::string_view str) {
+    if (str.empty()) {
+        return std::nullopt;
+    }
+    Bits bits{};
+    for (const char c : str) {
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        const auto digit = static_cast<Bits>(c - '0');
+        if (bits > (std::numeric_limits<Bits>::max() - digit) / 10) {
+            return std::nullopt;
+        }
+        bits = static_cast<Bits>(bits * 10 + digit);
+    }
+    return bits;
+}
+
+} // namespace detail
+
+template <typename E, typename OutputIt>
+OutputIt writeFlags(flags<E> f, OutputIt out) {
+    using Bits = typename flags<E>::bits_type;
+    constexpr auto& names = detail::flagNames<E>;
+    Bits unnamed{};
+    bool first = true;
+    for (auto bits = f.bits(); bits != 0; bits &= bits - 1) {
+        const auto bit = detail::countTrailingZeros(bits);
+        if (names[bit].empty()) {
+            unnamed |= static_cast<Bits>(Bits{1} << bit);
+            continue;
+        }
+        if (!first) {
+            *out++ = '|';
+        }
+        first = false;
+        out = std::copy(names[bit].begin(), names[bit].end(), out);
+    }
+    if (unnamed != 0) {
+        if (!first) {
+            *out++ = '|';
+        }
+        std::array<char, std::numeric_limits<Bits>::digits10 + 1> buffer;
+        const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), unnamed);
+        out = std::copy(buffer.data(), result.ptr, out);
+    }
+    return out;
+}
+
+template <typename E>
+std::string flagsToString(flags<E> f) {
+    std::string str;
+    writeFlags(f, std::back_inserter(str));
+    return str;
+}
+
+template <typename E>
+constexpr std::optional<flags<E>> tryFlagsFromString(std::string_view str) noexcept {
+    using Bits = typename flags<E>::bits_type;
+    flags<E> result;
+    if (detail::trimSpaces(str).empty()) {
+        return result;
+    }
+    for (;;) {
+        const auto separator = str.find('|');
+        const auto token = detail::trimSpaces(str.substr(0, separator));
+        if (const auto e = tryFromName<E>(token)) {
+            result.set(*e);
+        } else if (const auto bits = detail::parseFlagBits<Bits>(token)) {
+            result.set(flags<E>::fromBits(*bits));
+        } else {
+            return std::nullopt;
+        }
+        if (separator == std::string_view::npos) {
+            return result;
+        }
+        str.remove_prefix(separator + 1);
+    }
+}
+
+template <typename E>
+constexpr flags<E> flagsFromString(std::string_view str) {
+    if (const auto f = tryFlagsFromString<E>(str)) {
+        return *f;
+    }
+    // will cause compilation error in constexpr context
+    throw std::runtime_error{"No flags for string " + std::string{str}};
+}
+
+#endif // REFLECXX_GENERATION
+
+} // namespace reflecxx
+
+namespace std {
+template <typename E>
+struct hash<reflecxx::flags<E>> {
+    size_t operator()(reflecxx::flags<E> f) const noexcept {
+        return hash<typename reflecxx::flags<E>::bits_type>{}(f.bits());
+    }
+};
+} // namespace std
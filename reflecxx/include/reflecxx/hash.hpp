@@ -0,0 +1,136 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/detail/perfect_hash.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Hashing of reflecxx visitable types, consistent with reflecxx::equalTo.
+// The hash combines the hashes of every field, including those of base classes, in visitation order. Nested visitable
+// types, enums, C-style arrays and std::arrays are hashed recursively; any other field type needs a std::hash
+// specialization. Values are only meaningful within a single process, the same as for std::hash.
+
+namespace reflecxx {
+
+// Hash function object for T, usable as the Hash of unordered containers, e.g.
+//   std::unordered_map<Key, Value, reflecxx::hash<Key>>
+template <typename T>
+struct hash {
+    size_t operator()(const T& value) const noexcept;
+};
+
+// Returns the hash of value.
+template <typename T>
+size_t hashValue(const T& value) noexcept {
+    return hash<T>{}(value);
+}
+
+namespace detail {
+
+// Mixes h into seed, such that the result depends on the order in which hashes are combined.
+constexpr uint64_t hashCombine(uint64_t seed, uint64_t h) {
+    return mixHash(seed ^ h, 1) + 0x9e3779b97f4a7c15ull;
+}
+
+// Non-cryptographic hash of size bytes, a word at a time.
+inline uint64_t hashBytes(const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t h = mixHash(size);
+    for (; size >= sizeof(uint64_t); bytes += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        h = (h ^ mixHash(word)) * 0x9fb21c651e98df25ull;
+    }
+    if (size > 0) {
+        uint64_t word{};
+        std::memcpy(&word, bytes, size);
+        h = (h ^ mixHash(word)) * 0x9fb21c651e98df25ull;
+    }
+    return mixHash(h);
+}
+
+template <typename T>
+constexpr bool isBytewiseHashable();
+
+// True if equal values of T always have identical bytes, so the object representation can be hashed in one pass rather
+// than field by field. This rules out padding, floating point fields, where e.g. 0.0 == -0.0, and bytes belonging to
+// fields that aren't visitable, which reflecxx::equalTo doesn't compare.
+template <typename T>
+inline constexpr bool is_bytewise_hashable_v = isBytewiseHashable<T>();
+
+template <typename T>
+constexpr bool isBytewiseHashable() {
+    if constexpr (!std::has_unique_object_representations_v<T>) {
+        return false;
+    } else if constexpr (std::is_array_v<T>) {
+        return is_bytewise_hashable_v<std::remove_extent_t<T>>;
+    } else if constexpr (is_std_array<T>::value) {
+        return is_bytewise_hashable_v<typename T::value_type>;
+    } else if constexpr (std::is_class_v<T> && is_reflecxx_visitable_v<T>) {
+        // Fields never overlap, so if their sizes add up to the size of T, every byte of T belongs to one of them.
+        return std::apply(
+            [](const auto&... members) {
+                return (is_bytewise_hashable_v<typename remove_cvref_t<decltype(members)>::type> && ...) &&
+                       (size_t{0} + ... + sizeof(typename remove_cvref_t<decltype(members)>::type)) == sizeof(T);
+            },
+            flatFields<T>);
+    } else {
+        // Other classes may define equality any way they like.
+        return std::is_scalar_v<T>;
+    }
+}
+
+template <typename T>
+uint64_t hashOf(const T& value) {
+    if constexpr (is_bytewise_hashable_v<T>) {
+        return hashBytes(&value, sizeof(T));
+    } else if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+        uint64_t h = 0;
+        for (const auto& item : value) {
+            h = hashCombine(h, hashOf(item));
+        }
+        return h;
+    } else if constexpr (std::is_class_v<T> && is_reflecxx_visitable_v<T>) {
+        uint64_t h = 0;
+        applyForEach([&h](std::string_view, const auto& field) { h = hashCombine(h, hashOf(field)); }, value);
+        return h;
+    } else {
+        return std::hash<T>{}(value);
+    }
+}
+
+} // namespace detail
+
+template <typename T>
+size_t hash<T>::operator()(const T& value) const noexcept {
+    static_assert(is_reflecxx_visitable_v<T>, "reflecxx::hash requires a reflecxx visitable type!");
+    return static_cast<size_t>(detail::hashOf(value));
+}
+
+} // namespace reflecxx
+
+// Opts Type in to std::hash, using reflecxx::hash. Must be used in the global namespace, e.g.
+//   REFLECXX_STD_HASH(my_ns::MyStruct)
+// after which std::unordered_set<my_ns::MyStruct> works as is.
+#define REFLECXX_STD_HASH(Type)                  \
+    namespace std {                              \
+    template <>                                  \
+    struct hash<Type> : reflecxx::hash<Type> {}; \
+    }
+
+#endif // REFLECXX_GENERATION
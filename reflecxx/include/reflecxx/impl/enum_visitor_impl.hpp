@@ -4,14 +4,14 @@
 
 #pragma once
 
+#include <reflecxx/detail/enum_index.hpp>
+#include <reflecxx/detail/perfect_hash.hpp>
 #include <reflecxx/visit.hpp>
 
-namespace reflecxx {
+#include <stdexcept>
+#include <string>
 
-template <typename T>
-constexpr std::string_view getName() {
-    return MetaEnum<detail::remove_cvref_t<T>>::name;
-}
+namespace reflecxx {
 
 // Returns the number of enumerators in an enum.
 template <typename EnumType>
@@ -22,26 +22,51 @@ constexpr size_t enumSize() {
 // Returns the name of the enumerator as string.
 template <typename EnumType>
 constexpr std::string_view enumName(EnumType enumerator) {
-    for (const auto& e : MetaEnum<EnumType>::enumerators) {
-        if (e.enumerator == enumerator) {
-            return e.name;
-        }
+    const auto i = detail::enumValueIndex<EnumType>(static_cast<std::underlying_type_t<EnumType>>(enumerator));
+    if (i != detail::npos) {
+        return MetaEnum<EnumType>::enumerators[i].name;
     }
-    // should not be possible
+    // only possible if a value without an enumerator was cast to EnumType
     throw std::runtime_error{"Invalid enumerator."};
 }
 
+// Returns the name of the enumerator as string, or an empty view if there is no such enumerator.
+template <typename EnumType>
+constexpr std::string_view tryEnumName(EnumType enumerator) noexcept {
+    const auto i = detail::enumValueIndex<EnumType>(static_cast<std::underlying_type_t<EnumType>>(enumerator));
+    return i != detail::npos ? MetaEnum<EnumType>::enumerators[i].name : std::string_view{};
+}
+
 // Converts a name to a matching enumerator.
 template <typename EnumType>
 constexpr EnumType fromName(std::string_view enumeratorName) {
-    for (const auto& e : MetaEnum<EnumType>::enumerators) {
+    if (const auto e = tryFromName<EnumType>(enumeratorName)) {
+        return *e;
+    }
+    // will cause compilation error in constexpr context
+    throw std::runtime_error{"No enumerator for name " + std::string{enumeratorName}};
+}
+
+namespace detail {
+// Perfect hash of the enumerator names, built once per enum type at compile time.
+template <typename EnumType>
+inline constexpr auto enumNameHash = makePerfectHash(enumNames<EnumType>());
+} // namespace detail
+
+// Converts a name to a matching enumerator, or std::nullopt if there is no enumerator with that name.
+template <typename EnumType>
+constexpr std::optional<EnumType> tryFromName(std::string_view enumeratorName) noexcept {
+    if constexpr (enumSize<EnumType>() == 0) {
+        return std::nullopt;
+    } else {
+        // A single hash locates the only enumerator that could match, leaving just one string comparison.
+        const auto& e = MetaEnum<EnumType>::enumerators[detail::enumNameHash<EnumType>.find(enumeratorName)];
         // Can compare string_view with ==, unlike const char*.
         if (e.name == enumeratorName) {
             return e.enumerator;
         }
+        return std::nullopt;
     }
-    // will cause compilation error in constexpr context
-    throw std::runtime_error{"No enumerator for name " + std::string{enumeratorName}};
 }
 
 // Returns an array containing the names of all enumerators.
@@ -68,12 +93,22 @@ constexpr auto enumerators() -> std::array<EnumType, enumSize<EnumType>()> {
 // Can be used to determine if a static_cast to the enum type is safe.
 template <typename EnumType>
 constexpr bool enumContains(std::underlying_type_t<EnumType> targetValue) {
-    for (auto i = 0u; i < enumSize<EnumType>(); ++i) {
-        if (MetaEnum<EnumType>::enumerators[i].value == targetValue) {
-            return true;
-        }
+    return detail::enumValueIndex<EnumType>(targetValue) != detail::npos;
+}
+
+template <typename EnumType>
+constexpr size_t enumIndex(EnumType enumerator) {
+    if (const auto i = tryEnumIndex(enumerator)) {
+        return *i;
     }
-    return false;
+    // only possible if a value without an enumerator was cast to EnumType
+    throw std::runtime_error{"Invalid enumerator."};
+}
+
+template <typename EnumType>
+constexpr std::optional<size_t> tryEnumIndex(EnumType enumerator) noexcept {
+    const auto i = detail::enumValueIndex<EnumType>(static_cast<std::underlying_type_t<EnumType>>(enumerator));
+    return i != detail::npos ? std::optional<size_t>{i} : std::nullopt;
 }
 
 } // namespace reflecxx
@@ -4,103 +4,335 @@
 
 #pragma once
 
+#include <reflecxx/detail/perfect_hash.hpp>
 #include <reflecxx/visit.hpp>
 
-#include <cassert>
+#include <array>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<compare>) && __cplusplus > 201703L
+#include <compare>
+#endif
 
 namespace reflecxx {
 namespace detail {
 
-// Tag struct where the const-ness of type T matches that of S.
-// An alternative implementation could use std::conditional.
-template <typename T, typename S, bool = std::is_const_v<S>>
-struct match_const;
-
-template <typename T, typename S>
-struct match_const<T, S, false> {
-    using type = std::remove_const_t<T>;
-};
-template <typename T, typename S>
-struct match_const<T, S, true> {
-    using type = const std::remove_const_t<T>;
-};
-template <typename T, typename S>
-using match_const_t = typename match_const<T, S>::type;
-
 // existing forEach visit members which we don't care to do, so roll a custom case.
 template <typename... Ts>
 constexpr auto getBasesHelper(std::tuple<Ts...> bases) {
     constexpr auto v = [](auto baseClassTag) constexpr {
-        auto nextLevelBases = MetaStruct<decltype(baseClassTag)::type>::baseClasses;
+        auto nextLevelBases = MetaStruct<typename decltype(baseClassTag)::type>::baseClasses;
         return getBasesHelper(std::move(nextLevelBases));
     };
     return std::tuple_cat(std::move(bases), forEachAccum<true>(bases, std::move(v)));
 }
 
+template <typename T>
+constexpr bool hasFlatFields();
+
+// True if every field of T, including those of its base classes, can be reached through a pointer to member of T. This
+// isn't the case for a virtual base class, whose position in a T is only known at runtime, so the fields of such types
+// are reached through visit instead.
+template <typename T>
+inline constexpr bool has_flat_fields_v = hasFlatFields<T>();
+
+// True if pointers to members of B convert to pointers to members of T, and the same holds for the bases of B.
+template <typename B, typename T>
+inline constexpr bool is_flat_base_v = std::is_convertible_v<char B::*, char T::*> && has_flat_fields_v<B>;
+
+template <typename T>
+constexpr bool hasFlatFields() {
+    return std::apply(
+        [](auto... baseTags) { return (is_flat_base_v<typename decltype(baseTags)::type, T> && ...); },
+        MetaStruct<T>::baseClasses);
+}
+
+// Pointers to members of a base class implicitly convert to pointers to members of the derived class T, which lets the
+// base's fields be accessed directly from a T without going through a cast to the base.
+template <typename T, typename... Bs, typename... Ms>
+constexpr auto rebaseMembers(const std::tuple<ClassMember<Bs, Ms>...>& members) {
+    return std::apply([](const auto&... m) { return std::make_tuple(ClassMember<T, Ms>{m.ptr, m.name}...); }, members);
+}
+
+template <typename T>
+constexpr auto makeFlatFields();
+
+// Tuple of ClassMember<T, M> for every visitable field of T, including those of all base classes, in visitation order.
+template <typename T>
+inline constexpr auto flatFields = makeFlatFields<T>();
+
+template <typename T>
+constexpr auto makeFlatFields() {
+    static_assert(has_flat_fields_v<T>, "Fields inherited from a virtual base class can't be accessed through pointers "
+                                        "to members of the derived class; only visit based functions support them!");
+    if constexpr (has_flat_fields_v<T>) {
+        // Each level is a single tuple_cat of T's own fields and the already flattened fields of its direct bases.
+        return std::apply(
+            [](auto... baseTags) {
+                return std::tuple_cat(rebaseMembers<T>(ownFields<T>),
+                                      rebaseMembers<T>(flatFields<typename decltype(baseTags)::type>)...);
+            },
+            MetaStruct<T>::baseClasses);
+    } else {
+        return std::tuple<>{};
+    }
+}
+
+template <typename T, size_t... Is>
+constexpr auto makeFieldNames(std::index_sequence<Is...>) {
+    return std::array<std::string_view, sizeof...(Is)>{getName<Is, T>()...};
+}
+
+// Names of the visitable fields of T, in visitation order.
+template <typename T>
+inline constexpr auto fieldNames = makeFieldNames<T>(std::make_index_sequence<fieldCount<T>()>{});
+
+// Perfect hash over the distinct field names of a type, mapping each to the index of its field.
+template <size_t N>
+struct FieldNameHash {
+    PerfectHash<N> hash{};
+    // Index into fieldNames of the field with each distinct name, in the order of the hashed keys.
+    std::array<size_t, N> indices{};
+
+    // Returns the index of the only field whose name could be equal to key.
+    constexpr size_t find(std::string_view key) const { return indices[hash.find(key)]; }
+};
+
+// Number of distinct field names of T, which is less than the number of fields if a field shadows one of the same name
+// in a base class.
+template <typename T>
+constexpr size_t countFieldNames() {
+    constexpr auto& names = fieldNames<T>;
+    size_t count = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        bool shadowed = false;
+        for (size_t j = 0; j < i && !shadowed; ++j) {
+            shadowed = names[j] == names[i];
+        }
+        count += shadowed ? 0 : 1;
+    }
+    return count;
+}
+
+// Builds the hash of the field names of T. Of fields sharing a name, the first in visitation order wins, matching
+// fieldIndex.
+template <typename T>
+constexpr auto makeFieldNameHash() {
+    constexpr auto& names = fieldNames<T>;
+    constexpr auto m = countFieldNames<T>();
+    FieldNameHash<m> table{};
+    std::array<std::string_view, m> distinct{};
+    size_t k = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        bool shadowed = false;
+        for (size_t j = 0; j < k && !shadowed; ++j) {
+            shadowed = distinct[j] == names[i];
+        }
+        if (!shadowed) {
+            distinct[k] = names[i];
+            table.indices[k] = i;
+            ++k;
+        }
+    }
+    table.hash = makePerfectHash(distinct);
+    return table;
+}
+
+// Perfect hash of the field names of T, for constant time lookup of a field index by name.
+template <typename T>
+inline constexpr auto fieldNameHash = makeFieldNameHash<T>();
+
+// Applies visitor to the i'th field of obj, through a jump table indexed by field.
+template <typename T, typename Visitor, size_t... Is>
+void visitFieldAt(size_t i, T& obj, Visitor& visitor, std::index_sequence<Is...>) {
+    using FieldVisitor = void (*)(T&, Visitor&);
+    static constexpr FieldVisitor visitors[] = {
+        [](T& o, Visitor& v) { v(getName<Is, remove_cvref_t<T>>(), get<Is>(o)); }...};
+    visitors[i](obj, visitor);
+}
+
+template <size_t Offset, typename Visitor, size_t... Is, typename T, typename... Ts>
+constexpr void applyForEachImpl(Visitor& v, std::index_sequence<Is...>, T& t1, Ts&... ts) {
+    const auto applyOne = [&](auto index) {
+        constexpr size_t I = decltype(index)::value;
+        v(getName<I, remove_cvref_t<T>>(), get<I>(t1), get<I>(ts)...);
+    };
+    (applyOne(std::integral_constant<size_t, Offset + Is>{}), ...);
+}
+
+template <typename Visitor, typename T, size_t... Is>
+constexpr bool applyWhileImpl(Visitor& v, const T& t1, const T& t2, std::index_sequence<Is...>) {
+    return (v(getName<Is, T>(), get<Is>(t1), get<Is>(t2)) && ...);
+}
+
+// Applies v to each field of t1 and t2, pairwise, stopping at the first for which v returns false. Returns false if it
+// stopped early.
+template <typename Visitor, typename T>
+constexpr bool applyWhile(Visitor& v, const T& t1, const T& t2) {
+    return applyWhileImpl(v, t1, t2, std::make_index_sequence<fieldCount<T>()>{});
+}
+
+template <typename T>
+constexpr int threeWayImpl(const T& lhs, const T& rhs);
+
+// Negative if lhs orders before rhs, positive if after, zero if they are equivalent.
+template <typename T>
+constexpr int threeWayValue(const T& lhs, const T& rhs) {
+    if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+        for (size_t i = 0; i < std::size(lhs); ++i) {
+            if (const int c = threeWayValue(lhs[i], rhs[i]); c != 0) {
+                return c;
+            }
+        }
+        return 0;
+    } else if constexpr (std::is_class_v<T> && is_reflecxx_visitable_v<T>) {
+        return threeWayImpl(lhs, rhs);
+    } else {
+        return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+    }
+}
+
+template <typename T>
+constexpr int threeWayImpl(const T& lhs, const T& rhs) {
+    int result = 0;
+    auto v = [&result](std::string_view, const auto& l, const auto& r) {
+        result = threeWayValue(l, r);
+        return result == 0;
+    };
+    applyWhile(v, lhs, rhs);
+    return result;
+}
+
 } // namespace detail
 
 template <typename T>
 constexpr auto getVisitableTypes() {
+    using CleanT = detail::remove_cvref_t<T>;
     // build a tuple of type tags representing the visitable types
-    constexpr auto v = [](std::string_view, const auto& tag) constexpr { return tag; };
-    return visitAccummulate<T>(std::move(v));
+    if constexpr (detail::has_flat_fields_v<CleanT>) {
+        return std::apply(
+            [](const auto&... members) {
+                return std::make_tuple(type_tag<typename detail::remove_cvref_t<decltype(members)>::type>{}...);
+            },
+            detail::flatFields<CleanT>);
+    } else {
+        constexpr auto v = [](std::string_view, const auto& tag) constexpr { return tag; };
+        return visitAccummulate<CleanT>(std::move(v));
+    }
 }
 
 template <size_t I, typename T>
 constexpr auto getType() {
-    auto t = getVisitableTypes<T>();
-    return std::get<I>(t);
+    static_assert(I < fieldCount<T>(), "Index out of range!");
+    using CleanT = detail::remove_cvref_t<T>;
+    if constexpr (detail::has_flat_fields_v<CleanT>) {
+        return type_tag<typename std::tuple_element_t<I, decltype(detail::flatFields<CleanT>)>::type>{};
+    } else {
+        return std::get<I>(getVisitableTypes<CleanT>());
+    }
 }
 
 template <size_t I, typename T>
 constexpr auto& get(T& obj) {
-    // This gives a more obvious error than when typeAt fails to compile
+    // This gives a more obvious error than when std::get fails to compile
     static_assert(I < fieldCount<T>(), "Index out of range!");
-
-    // The const-ness of the pointer to member must match the const-ness of T
-    detail::match_const_t<typeAt<I, detail::remove_cvref_t<T>>, T>* ptr = nullptr;
-    auto count = 0;
-    auto v = [&count, &ptr ](std::string_view, auto& member) constexpr {
-        if constexpr (std::is_same_v<detail::remove_cvref_t<decltype(*ptr)>,
-                                     detail::remove_cvref_t<decltype(member)>>) {
-            if (count == I)
-                ptr = &member;
-        }
-        count++;
-    };
-    visit(obj, std::move(v));
-    assert(ptr);
-    return *ptr;
+    using CleanT = detail::remove_cvref_t<T>;
+    if constexpr (detail::has_flat_fields_v<CleanT>) {
+        // A single pointer to member dereference; the const-ness of the result follows that of obj.
+        return obj.*std::get<I>(detail::flatFields<CleanT>).ptr;
+    } else {
+        // Visiting casts obj to each base class, virtual ones included, and counts off the fields to the I'th.
+        using M = typeAt<I, CleanT>;
+        detail::match_const_t<M, T>* ptr = nullptr;
+        size_t count = 0;
+        auto v = [&count, &ptr](std::string_view, auto& member) {
+            if constexpr (std::is_same_v<M, detail::remove_cvref_t<decltype(member)>>) {
+                if (count == I) {
+                    ptr = &member;
+                }
+            }
+            ++count;
+        };
+        visit(obj, std::move(v));
+        return *ptr;
+    }
 }
 
 template <typename T>
 constexpr size_t fieldCount() {
-    size_t count = 0;
-    constexpr auto v = [&count](std::string_view, const auto&) constexpr { count++; };
-    visit<T>(std::move(v));
-    return count;
-}
-
-template <typename T>
-constexpr std::string_view getName() {
-    return MetaStruct<detail::remove_cvref_t<T>>::name;
+    using CleanT = detail::remove_cvref_t<T>;
+    if constexpr (detail::has_flat_fields_v<CleanT>) {
+        return std::tuple_size_v<detail::remove_cvref_t<decltype(detail::flatFields<CleanT>)>>;
+    } else {
+        size_t count = 0;
+        auto v = [&count](std::string_view, const auto&) constexpr { ++count; };
+        visit<CleanT>(std::move(v));
+        return count;
+    }
 }
 
 template <size_t I, typename T>
 constexpr std::string_view getName() {
     static_assert(I < fieldCount<T>(), "Index out of range!");
+    using CleanT = detail::remove_cvref_t<T>;
+    if constexpr (detail::has_flat_fields_v<CleanT>) {
+        return std::get<I>(detail::flatFields<CleanT>).name;
+    } else {
+        size_t count = 0;
+        std::string_view out;
+        auto v = [&count, &out](std::string_view name, const auto&) constexpr {
+            if (count == I) {
+                out = name;
+            }
+            ++count;
+        };
+        visit<CleanT>(std::move(v));
+        return out;
+    }
+}
 
-    size_t count = 0;
-    std::string_view out;
-    auto v = [&count, &out ](std::string_view name, const auto&) constexpr {
-        if (count == I) {
-            out = name;
+template <typename T>
+constexpr size_t fieldIndex(std::string_view name) {
+    // A linear scan, so that it can be used for types with shadowed field names; when evaluated at compile time it has
+    // no runtime cost anyway.
+    constexpr auto& names = detail::fieldNames<detail::remove_cvref_t<T>>;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) {
+            return i;
         }
-        count++;
-    };
-    visit<T>(std::move(v));
-    assert(!out.empty());
-    return out;
+    }
+    // will cause compilation error in constexpr context
+    throw std::runtime_error{"No field named " + std::string{name}};
+}
+
+template <typename T>
+constexpr bool hasField(std::string_view name) {
+    for (const auto& fieldName : detail::fieldNames<detail::remove_cvref_t<T>>) {
+        if (fieldName == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T, typename Visitor>
+bool getByName(T& obj, std::string_view name, Visitor&& visitor) {
+    using CleanT = detail::remove_cvref_t<T>;
+    if constexpr (fieldCount<CleanT>() == 0) {
+        return false;
+    } else {
+        // A single hash locates the only field that could match, leaving just one string comparison.
+        const auto i = detail::fieldNameHash<CleanT>.find(name);
+        if (detail::fieldNames<CleanT>[i] != name) {
+            return false;
+        }
+        detail::visitFieldAt(i, obj, visitor, std::make_index_sequence<fieldCount<CleanT>()>{});
+        return true;
+    }
 }
 
 template <typename T>
@@ -111,16 +343,13 @@ constexpr auto getBases() {
 // The variadic template args need to be last or type deduction doesn't work properly.
 template <size_t I, typename Visitor, typename T, typename... Ts, typename>
 constexpr void applyForEach(Visitor&& v, T&& t1, Ts&&... ts) {
-    v(getName<I, T>(), get<I>(t1), get<I>(ts)...);
-    if constexpr (I + 1 < fieldCount<T>()) {
-        applyForEach<I + 1>(std::forward<Visitor>(v), std::forward<T>(t1), std::forward<T>(ts)...);
-    }
+    detail::applyForEachImpl<I>(v, std::make_index_sequence<fieldCount<T>() - I>{}, t1, ts...);
 }
 
 template <typename T, typename O>
 constexpr bool compare(const T& t1, const T& t2, const O& op) {
-    bool res = true;
-    auto v = [&res, &op](std::string_view n, const auto& val1, const auto& val2) {
+    // Returns whether to keep going, so that iteration stops as soon as the result is known.
+    auto v = [&op](std::string_view, const auto& val1, const auto& val2) -> bool {
         static_assert(std::is_same_v<decltype(val1), decltype(val2)>);
 
         if constexpr (std::is_array_v<detail::remove_cvref_t<decltype(val1)>>) {
@@ -128,26 +357,58 @@ constexpr bool compare(const T& t1, const T& t2, const O& op) {
             const auto size1 = sizeof(val1) / sizeof(val1[0]);
             const auto size2 = sizeof(val2) / sizeof(val2[0]);
 
-            res = (res && op(size1, size2));
-            if (!res) {
-                // break early
-                return;
+            if (!op(size1, size2)) {
+                return false;
             }
             for (auto i = 0u; i < size1; ++i) {
-                // Recurse to handle whatever type the array members are
-                res = (res && compare(val1[i], val2[i], op));
-                if (!res) {
-                    // break early
-                    return;
+                // Recurse to handle visitable array members
+                using ElementType = detail::remove_cvref_t<decltype(val1[i])>;
+                if constexpr (std::is_class_v<ElementType> && is_reflecxx_visitable_v<ElementType>) {
+                    if (!compare(val1[i], val2[i], op)) {
+                        return false;
+                    }
+                } else if (!op(val1[i], val2[i])) {
+                    return false;
                 }
             }
+            return true;
         } else {
-            res = (res && op(val1, val2));
+            return static_cast<bool>(op(val1, val2));
         }
     };
 
-    applyForEach(std::move(v), t1, t2);
-    return res;
+    return detail::applyWhile(v, t1, t2);
+}
+
+template <typename T>
+constexpr bool lessThan(const T& lhs, const T& rhs) {
+    // In a single pass, every field must be less than or equal, and at least one of them not equal.
+    bool anyLess = false;
+    const auto lessEqual = [&anyLess](const auto& a, const auto& b) {
+        if (!(a <= b)) {
+            return false;
+        }
+        anyLess = anyLess || !(a == b);
+        return true;
+    };
+    return compare(lhs, rhs, lessEqual) && anyLess;
+}
+
+template <typename T>
+constexpr bool greaterThan(const T& lhs, const T& rhs) {
+    return lessThan(rhs, lhs);
+}
+
+template <typename T>
+constexpr auto threeWay(const T& lhs, const T& rhs) {
+    const int result = detail::threeWayImpl(lhs, rhs);
+#if defined(__cpp_lib_three_way_comparison)
+    return result < 0   ? std::weak_ordering::less
+           : result > 0 ? std::weak_ordering::greater
+                        : std::weak_ordering::equivalent;
+#else
+    return result;
+#endif
 }
 
 } // namespace reflecxx
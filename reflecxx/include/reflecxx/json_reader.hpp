@@ -0,0 +1,509 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/enum_visitor.hpp>
+#include <reflecxx/flags.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Streaming JSON deserialization of reflecxx visitable types, without any dependency on a JSON library.
+// The text is parsed in a single pass directly into the destination object, without building an intermediate document.
+// Object keys are matched against a perfect hash of the reflected field names built at compile time, after first
+// checking the field following the previously read one, which is the only comparison needed when keys arrive in
+// declaration order. Every field of a struct must be present; keys that don't name a field are skipped.
+// Reflected enums are read from their enumerator names or from numbers, reflecxx::flags from enumerator names separated
+// by '|' or from numbers, and null is read as NaN into floating point
+// values, mirroring json_writer.hpp.
+
+namespace reflecxx {
+
+// Parses the JSON text json into value. Throws std::runtime_error if the text is malformed or doesn't match the
+// structure of T.
+template <typename T>
+void readJson(std::string_view json, T& value);
+
+// Returns a T parsed from the JSON text json.
+template <typename T>
+T fromJsonString(std::string_view json);
+
+// Like readJson, but fields of value missing from the top level JSON object keep their current values, for applying
+// partial updates.
+template <typename T>
+void readJsonFields(std::string_view json, T& value);
+
+#if defined(__cpp_lib_memory_resource)
+// Like readJson, but every pmr container in value, such as a std::pmr::string or std::pmr::vector field at any depth,
+// allocates from resource. With a monotonic or pool resource, a whole message is then freed at once by releasing the
+// resource, rather than container by container.
+template <typename T>
+void readJson(std::string_view json, T& value, std::pmr::memory_resource* resource);
+#endif
+
+namespace detail {
+
+// Reads JSON text from a contiguous buffer.
+struct JsonReader {
+    JsonReader(std::string_view json)
+    : begin(json.data())
+    , pos(json.data())
+    , end(json.data() + json.size()) {}
+
+#if defined(__cpp_lib_memory_resource)
+    // pmr containers are made to allocate from resource before they're read into.
+    JsonReader(std::string_view json, std::pmr::memory_resource* resource)
+    : JsonReader(json) {
+        this->resource = resource;
+    }
+#endif
+
+    template <typename T>
+    void readValue(T& value) {
+#if defined(__cpp_lib_memory_resource)
+        if constexpr (is_pmr_container<T>::value) {
+            if (resource) {
+                useResource(value, resource);
+            }
+        }
+#endif
+        if constexpr (std::is_same_v<T, bool>) {
+            skipWhitespace();
+            if (pos != end && *pos == 't') {
+                readLiteral("true");
+                value = true;
+            } else {
+                readLiteral("false");
+                value = false;
+            }
+        } else if constexpr (std::is_enum_v<T>) {
+            if constexpr (is_reflecxx_visitable_v<T>) {
+                skipWhitespace();
+                if (pos != end && *pos == '"') {
+                    const auto name = readString();
+                    if (const auto e = tryFromName<T>(name)) {
+                        value = *e;
+                        return;
+                    }
+                    fail("no enumerator for name " + std::string{name});
+                }
+            }
+            std::underlying_type_t<T> number{};
+            readNumber(number);
+            value = static_cast<T>(number);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            readNumber(value);
+        } else if constexpr (is_string<T>::value) {
+            value = readString();
+        } else if constexpr (is_optional<T>::value) {
+            skipWhitespace();
+            if (pos != end && *pos == 'n') {
+                readLiteral("null");
+                value.reset();
+            } else {
+                readValue(value.emplace());
+            }
+        } else if constexpr (is_flags<T>::value) {
+            skipWhitespace();
+            if (pos != end && *pos == '"') {
+                const auto str = readString();
+                if (const auto f = tryFlagsFromString<typename T::enum_type>(str)) {
+                    value = *f;
+                    return;
+                }
+                fail("no flags for string " + std::string{str});
+            }
+            typename T::bits_type bits{};
+            readNumber(bits);
+            value = T::fromBits(bits);
+        } else if constexpr (is_reflecxx_visitable_v<T>) {
+            readObject(value, std::make_index_sequence<fieldCount<T>()>{});
+        } else if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+            // Fixed size arrays must match exactly.
+            size_t i = 0;
+            if (beginContainer('[', ']')) {
+                do {
+                    if (i == std::size(value)) {
+                        fail("too many array elements");
+                    }
+                    readValue(value[i++]);
+                } while (nextElement(']'));
+            }
+            if (i != std::size(value)) {
+                fail("too few array elements");
+            }
+        } else {
+            static_assert(is_emplace_back_container<T>::value, "Type is not supported by JSON deserialization!");
+            value.clear();
+            if (beginContainer('[', ']')) {
+                do {
+                    readValue(value.emplace_back());
+                } while (nextElement(']'));
+            }
+        }
+    }
+
+    // Reads a JSON object into the fields of value, leaving any fields that aren't present unchanged.
+    template <typename T>
+    void readFields(T& value) {
+        static_assert(is_reflecxx_visitable_v<T> && std::is_class_v<T>, "Type must be a reflecxx visitable class!");
+        readObject<false>(value, std::make_index_sequence<fieldCount<T>()>{});
+    }
+
+    // Checks that nothing but whitespace follows the parsed value.
+    void finish() {
+        skipWhitespace();
+        if (pos != end) {
+            fail("unexpected trailing characters");
+        }
+    }
+
+ private:
+    template <bool RequireAll = true, typename T, size_t... Is>
+    void readObject(T& obj, std::index_sequence<Is...>) {
+        constexpr size_t n = sizeof...(Is);
+        std::array<bool, n> seen{};
+        size_t found = 0;
+        // Index of the field expected next if keys are in declaration order.
+        size_t next = 0;
+
+        if (beginContainer('{', '}')) {
+            do {
+                const auto key = readString();
+                expect(':');
+                if constexpr (n > 0) {
+                    // Jump table from runtime field index to the reader for that field's type.
+                    using FieldReader = void (*)(JsonReader&, T&);
+                    static constexpr std::array<FieldReader, n> readers{{[](JsonReader& reader, T& o) {
+                        reader.readValue(o.*std::get<Is>(flatFields<T>).ptr);
+                    }...}};
+                    constexpr auto& names = fieldNames<T>;
+
+                    auto i = next;
+                    if (i >= n || names[i] != key) {
+                        i = fieldNameHash<T>.find(key);
+                        if (names[i] != key) {
+                            skipValue();
+                            continue;
+                        }
+                    }
+                    readers[i](*this, obj);
+                    if (!seen[i]) {
+                        seen[i] = true;
+                        ++found;
+                    }
+                    next = i + 1;
+                } else {
+                    skipValue();
+                }
+            } while (nextElement('}'));
+        }
+
+        if (RequireAll && found != n) {
+            for (size_t i = 0; i < n; ++i) {
+                if (!seen[i]) {
+                    fail("missing field " + std::string{fieldNames<T>[i]});
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void readNumber(T& value) {
+        skipWhitespace();
+        if constexpr (std::is_floating_point_v<T>) {
+            if (pos != end && *pos == 'n') {
+                readLiteral("null");
+                value = std::numeric_limits<T>::quiet_NaN();
+                return;
+            }
+        }
+        const auto* start = pos;
+        while (pos != end && isNumberChar(*pos)) {
+            ++pos;
+        }
+        // Integers must be written as integers; from_chars stops at a decimal point or exponent.
+        const auto result = std::from_chars(start, pos, value);
+        if (result.ec != std::errc{} || result.ptr != pos) {
+            pos = start;
+            fail(result.ec == std::errc::result_out_of_range ? "number out of range" : "invalid number");
+        }
+    }
+
+    // Reads a string, returning a view of the input when it contains no escapes, otherwise of the unescaped copy. The
+    // view is valid until the next string is read.
+    std::string_view readString() {
+        expect('"');
+        const auto* start = pos;
+        while (pos != end && *pos != '"' && *pos != '\\') {
+            ++pos;
+        }
+        if (pos != end && *pos == '"') {
+            return {start, static_cast<size_t>(pos++ - start)};
+        }
+        unescaped.assign(start, pos);
+        for (;;) {
+            if (pos == end) {
+                fail("unterminated string");
+            }
+            if (*pos++ == '"') {
+                return unescaped;
+            }
+            readEscape();
+            start = pos;
+            while (pos != end && *pos != '"' && *pos != '\\') {
+                ++pos;
+            }
+            unescaped.append(start, pos);
+        }
+    }
+
+    // Appends the character(s) for the escape sequence following a backslash to unescaped.
+    void readEscape() {
+        if (pos == end) {
+            fail("unterminated string");
+        }
+        switch (*pos++) {
+        case '"':
+            unescaped += '"';
+            break;
+        case '\\':
+            unescaped += '\\';
+            break;
+        case '/':
+            unescaped += '/';
+            break;
+        case 'b':
+            unescaped += '\b';
+            break;
+        case 'f':
+            unescaped += '\f';
+            break;
+        case 'n':
+            unescaped += '\n';
+            break;
+        case 'r':
+            unescaped += '\r';
+            break;
+        case 't':
+            unescaped += '\t';
+            break;
+        case 'u': {
+            auto codePoint = readHex4();
+            if (codePoint >= 0xd800 && codePoint < 0xdc00) {
+                // High surrogate, must be followed by the escaped low surrogate.
+                readLiteral("\\u");
+                const auto low = readHex4();
+                if (low < 0xdc00 || low >= 0xe000) {
+                    fail("invalid surrogate pair");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+            }
+            appendUtf8(codePoint);
+            break;
+        }
+        default:
+            --pos;
+            fail("invalid escape sequence");
+        }
+    }
+
+    uint32_t readHex4() {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i, ++pos) {
+            if (pos == end) {
+                fail("unterminated string");
+            }
+            const char c = *pos;
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                value |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                value |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                fail("invalid unicode escape");
+            }
+        }
+        return value;
+    }
+
+    void appendUtf8(uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            unescaped += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            unescaped += static_cast<char>(0xc0 | (codePoint >> 6));
+            unescaped += static_cast<char>(0x80 | (codePoint & 0x3f));
+        } else if (codePoint < 0x10000) {
+            unescaped += static_cast<char>(0xe0 | (codePoint >> 12));
+            unescaped += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+            unescaped += static_cast<char>(0x80 | (codePoint & 0x3f));
+        } else {
+            unescaped += static_cast<char>(0xf0 | (codePoint >> 18));
+            unescaped += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+            unescaped += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+            unescaped += static_cast<char>(0x80 | (codePoint & 0x3f));
+        }
+    }
+
+    // Skips over a value that doesn't correspond to a field. Only strings and the nesting of brackets are checked.
+    void skipValue() {
+        size_t depth = 0;
+        do {
+            skipWhitespace();
+            if (pos == end) {
+                fail("unexpected end of input");
+            }
+            switch (*pos) {
+            case '"':
+                ++pos;
+                while (pos != end && *pos != '"') {
+                    pos += *pos == '\\' && pos + 1 != end ? 2 : 1;
+                }
+                expect('"');
+                break;
+            case '{':
+            case '[':
+                ++depth;
+                ++pos;
+                break;
+            case '}':
+            case ']':
+            case ',':
+            case ':':
+                if (depth == 0) {
+                    fail("expected a value");
+                }
+                depth -= *pos == '}' || *pos == ']';
+                ++pos;
+                break;
+            default: {
+                // A number or literal.
+                const auto* start = pos;
+                while (pos != end && (isNumberChar(*pos) || (*pos >= 'a' && *pos <= 'z'))) {
+                    ++pos;
+                }
+                if (pos == start) {
+                    fail("expected a value");
+                }
+            }
+            }
+        } while (depth > 0);
+    }
+
+    static constexpr bool isNumberChar(char c) {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    void skipWhitespace() {
+        while (pos != end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) {
+            ++pos;
+        }
+    }
+
+    void expect(char c) {
+        skipWhitespace();
+        if (pos == end || *pos != c) {
+            fail(std::string{"expected '"} + c + "'");
+        }
+        ++pos;
+    }
+
+    void readLiteral(std::string_view literal) {
+        if (std::string_view{pos, static_cast<size_t>(end - pos)}.substr(0, literal.size()) != literal) {
+            fail("expected " + std::string{literal});
+        }
+        pos += literal.size();
+    }
+
+    // Consumes the opening bracket of an array or object, returning true if it has any elements.
+    bool beginContainer(char open, char close) {
+        expect(open);
+        skipWhitespace();
+        if (pos != end && *pos == close) {
+            ++pos;
+            return false;
+        }
+        return true;
+    }
+
+    // Consumes the separator following an element, returning true if another element follows.
+    bool nextElement(char close) {
+        skipWhitespace();
+        if (pos != end && *pos == ',') {
+            ++pos;
+            return true;
+        }
+        expect(close);
+        return false;
+    }
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error{"JSON parse error at offset " + std::to_string(pos - begin) + ": " + what};
+    }
+
+    const char* begin;
+    const char* pos;
+    const char* end;
+    // Storage for strings containing escape sequences.
+    std::string unescaped;
+#if defined(__cpp_lib_memory_resource)
+    std::pmr::memory_resource* resource{};
+#endif
+};
+
+} // namespace detail
+
+template <typename T>
+void readJson(std::string_view json, T& value) {
+    detail::JsonReader reader{json};
+    reader.readValue(value);
+    reader.finish();
+}
+
+template <typename T>
+T fromJsonString(std::string_view json) {
+    T value{};
+    readJson(json, value);
+    return value;
+}
+
+template <typename T>
+void readJsonFields(std::string_view json, T& value) {
+    detail::JsonReader reader{json};
+    reader.readFields(value);
+    reader.finish();
+}
+
+#if defined(__cpp_lib_memory_resource)
+template <typename T>
+void readJson(std::string_view json, T& value, std::pmr::memory_resource* resource) {
+    detail::JsonReader reader{json, resource};
+    reader.readValue(value);
+    reader.finish();
+}
+#endif
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
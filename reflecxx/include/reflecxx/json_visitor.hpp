@@ -8,32 +8,16 @@
 // get compiled by the generator, don't define it during generation.
 #ifndef REFLECXX_GENERATION
 
+#include <reflecxx/flags.hpp>
 #include <reflecxx/visit.hpp>
 
 // Note: This library does not link against/set include dirs for nlohmann json by default!
 #include <nlohmann/json.hpp>
 
+#include <iterator>
+#include <stdexcept>
 #include <string>
 
-// Automatically define to/from nlohmann JSON functions for any reflecxx visitable type. Wow!
-// Note that since this uses the adl_serializer, if specialization for any type is desired it must also be done by
-// specializing this adl_serializer struct rather than defining the to_json/from_json free functions (since ADL into the
-// argument namespace will no longer apply).
-namespace nlohmann {
-template <typename T>
-struct adl_serializer<T, std::enable_if_t<reflecxx::is_reflecxx_visitable_v<T>>> {
-    static void to_json(json& j, const T& t) {
-        reflecxx::ToJsonVisitor v{j};
-        reflecxx::visit(t, std::move(v));
-    }
-
-    static void from_json(const json& j, T& t) {
-        reflecxx::FromJsonVisitor v{j};
-        reflecxx::visit(t, std::move(v));
-    }
-};
-} // namespace nlohmann
-
 namespace reflecxx {
 
 // Visitor functor for converting a named value (such as a class member) to JSON.
@@ -57,6 +41,14 @@ struct FromJsonVisitor {
     FromJsonVisitor(const nlohmann::json& value)
     : jsonValue(value) {}
 
+#if defined(__cpp_lib_memory_resource)
+    // pmr containers at any depth within the visited object, such as std::pmr::string and std::pmr::vector fields, are
+    // made to allocate from resource.
+    FromJsonVisitor(const nlohmann::json& value, std::pmr::memory_resource* resource)
+    : jsonValue(value)
+    , resource(resource) {}
+#endif
+
     template <typename T>
     void operator()(std::string_view name, T& member) const {
         // std::string required, https://github.com/nlohmann/json/issues/1529
@@ -64,25 +56,95 @@ struct FromJsonVisitor {
     }
 
     const nlohmann::json& jsonValue;
+#if defined(__cpp_lib_memory_resource)
+    std::pmr::memory_resource* resource{};
+#endif
 
  private:
     template <typename T>
     void fromJson(T& value, const nlohmann::json& jsonObj) const {
+#if defined(__cpp_lib_memory_resource)
+        // nlohmann::json.get() would return a container using the default resource, so the resource has to be threaded
+        // through every level that may contain a pmr container.
+        if (resource) {
+            if constexpr (detail::is_pmr_container<T>::value && detail::is_string<T>::value) {
+                detail::useResource(value, resource);
+                value = jsonObj.get_ref<const std::string&>();
+                return;
+            } else if constexpr (detail::is_pmr_container<T>::value) {
+                detail::useResource(value, resource);
+                value.clear();
+                for (const auto& item : jsonObj) {
+                    fromJson(value.emplace_back(), item);
+                }
+                return;
+            } else if constexpr (detail::is_std_array<T>::value) {
+                fromJsonArray(value, jsonObj);
+                return;
+            } else if constexpr (std::is_class_v<T> && is_reflecxx_visitable_v<T>) {
+                reflecxx::visit(value, FromJsonVisitor{jsonObj, resource});
+                return;
+            }
+        }
+#endif
         value = jsonObj.get<T>();
     }
     // nlohmann::json.get() doesn't handle c-style arrays
     template <typename T, size_t N>
     void fromJson(T (&arr)[N], const nlohmann::json& jsonObj) const {
-        if (jsonObj.size() != N) {
+        fromJsonArray(arr, jsonObj);
+    }
+
+    template <typename A>
+    void fromJsonArray(A& arr, const nlohmann::json& jsonObj) const {
+        if (jsonObj.size() != std::size(arr)) {
             throw std::runtime_error("JSON array size is different than expected");
         }
         size_t index = 0;
         for (auto& item : jsonObj) {
-            arr[index++] = item.get<T>();
+            fromJson(arr[index++], item);
         }
     }
 };
 
+#if defined(__cpp_lib_memory_resource)
+// Converts from JSON to value, with every pmr container in value allocating from resource. With a monotonic or pool
+// resource, a whole message is then freed at once by releasing the resource, rather than container by container.
+template <typename T>
+void fromJson(const nlohmann::json& j, T& value, std::pmr::memory_resource* resource) {
+    reflecxx::visit(value, FromJsonVisitor{j, resource});
+}
+#endif
+
 } // namespace reflecxx
 
+// Automatically define to/from nlohmann JSON functions for any reflecxx visitable type. Wow!
+// Note that since this uses the adl_serializer, if specialization for any type is desired it must also be done by
+// specializing this adl_serializer struct rather than defining the to_json/from_json free functions (since ADL into the
+// argument namespace will no longer apply).
+namespace nlohmann {
+template <typename T>
+struct adl_serializer<T, std::enable_if_t<reflecxx::is_reflecxx_visitable_v<T>>> {
+    static void to_json(json& j, const T& t) {
+        reflecxx::ToJsonVisitor v{j};
+        reflecxx::visit(t, std::move(v));
+    }
+
+    static void from_json(const json& j, T& t) {
+        reflecxx::FromJsonVisitor v{j};
+        reflecxx::visit(t, std::move(v));
+    }
+};
+
+// Flags are strings of enumerator names separated by '|'.
+template <typename E>
+struct adl_serializer<reflecxx::flags<E>> {
+    static void to_json(json& j, const reflecxx::flags<E>& f) { j = reflecxx::flagsToString(f); }
+
+    static void from_json(const json& j, reflecxx::flags<E>& f) {
+        f = reflecxx::flagsFromString<E>(j.get_ref<const std::string&>());
+    }
+};
+} // namespace nlohmann
+
 #endif // REFLECXX_GENERATION
@@ -0,0 +1,226 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/enum_visitor.hpp>
+#include <reflecxx/flags.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Streaming JSON serialization of reflecxx visitable types, without any dependency on a JSON library.
+// Text is written directly to an output iterator, without building an intermediate document. Object keys, including
+// their quotes, escaping and separators, are precomputed at compile time from the reflected field names.
+// Reflected enums are written as their enumerator names, reflecxx::flags as a string of enumerator names separated by
+// '|', numbers are formatted with std::to_chars, and non-finite floating point values are written as null. Char arrays
+// are written as arrays of numbers, like other C-style arrays, since they may hold NUL bytes.
+
+namespace reflecxx {
+
+// Writes value as JSON text to out. Returns the output iterator one past the last character written.
+template <typename T, typename OutputIt>
+OutputIt writeJson(const T& value, OutputIt out);
+
+// Returns value as JSON text.
+template <typename T>
+std::string toJsonString(const T& value);
+
+namespace detail {
+
+// Returns the length of str once escaped for use in a JSON string.
+constexpr size_t jsonEscapedSize(std::string_view str) {
+    size_t size = 0;
+    for (const char c : str) {
+        if (c == '"' || c == '\\' || c == '\b' || c == '\f' || c == '\n' || c == '\r' || c == '\t') {
+            size += 2;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            size += 6;
+        } else {
+            size += 1;
+        }
+    }
+    return size;
+}
+
+// Writes str, escaped for use in a JSON string, to out.
+template <typename OutputIt>
+constexpr OutputIt jsonEscape(std::string_view str, OutputIt out) {
+    constexpr std::string_view hex = "0123456789abcdef";
+    for (const char c : str) {
+        const auto escape = [&out](char e) {
+            *out++ = '\\';
+            *out++ = e;
+        };
+        switch (c) {
+        case '"':
+            escape('"');
+            break;
+        case '\\':
+            escape('\\');
+            break;
+        case '\b':
+            escape('b');
+            break;
+        case '\f':
+            escape('f');
+            break;
+        case '\n':
+            escape('n');
+            break;
+        case '\r':
+            escape('r');
+            break;
+        case '\t':
+            escape('t');
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                escape('u');
+                *out++ = '0';
+                *out++ = '0';
+                *out++ = hex[static_cast<unsigned char>(c) >> 4];
+                *out++ = hex[static_cast<unsigned char>(c) & 0xf];
+            } else {
+                *out++ = c;
+            }
+        }
+    }
+    return out;
+}
+
+// The key of the I'th field of T, escaped and quoted, along with the preceding separator, e.g. ,"name":
+// Computed at compile time, so writing a key is a single copy.
+template <typename T, size_t I>
+struct JsonKey {
+    static constexpr std::string_view name = std::get<I>(flatFields<T>).name;
+    static constexpr auto chars = [] {
+        std::array<char, jsonEscapedSize(name) + 4> key{};
+        key[0] = I == 0 ? '{' : ',';
+        key[1] = '"';
+        auto end = jsonEscape(name, key.begin() + 2);
+        *end++ = '"';
+        *end = ':';
+        return key;
+    }();
+    static constexpr std::string_view value{chars.data(), chars.size()};
+};
+
+// Writes JSON text to an output iterator.
+template <typename OutputIt>
+struct JsonWriter {
+    void write(std::string_view str) { out = std::copy(str.begin(), str.end(), out); }
+
+    template <typename T>
+    void writeValue(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            write(value ? "true" : "false");
+        } else if constexpr (std::is_enum_v<T>) {
+            if constexpr (is_reflecxx_visitable_v<T>) {
+                if (const auto name = tryEnumName(value); !name.empty()) {
+                    writeString(name);
+                    return;
+                }
+            }
+            writeNumber(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            writeNumber(value);
+        } else if constexpr (!std::is_array_v<T> && std::is_convertible_v<const T&, std::string_view>) {
+            writeString(value);
+        } else if constexpr (is_optional<T>::value) {
+            if (value) {
+                writeValue(*value);
+            } else {
+                write("null");
+            }
+        } else if constexpr (is_flags<T>::value) {
+            *out++ = '"';
+            out = writeFlags(value, out);
+            *out++ = '"';
+        } else if constexpr (is_reflecxx_visitable_v<T>) {
+            writeObject(value, std::make_index_sequence<fieldCount<T>()>{});
+        } else {
+            static_assert(is_iterable<T>::value, "Type is not supported by JSON serialization!");
+            *out++ = '[';
+            bool first = true;
+            for (const auto& item : value) {
+                if (!first) {
+                    *out++ = ',';
+                }
+                first = false;
+                writeValue(item);
+            }
+            *out++ = ']';
+        }
+    }
+
+    OutputIt out;
+
+ private:
+    template <typename T>
+    void writeNumber(T value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(value)) {
+                write("null");
+                return;
+            }
+        }
+        // Large enough for the shortest round trip representation of any arithmetic type.
+        std::array<char, 64> buffer;
+        const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        write({buffer.data(), static_cast<size_t>(result.ptr - buffer.data())});
+    }
+
+    void writeString(std::string_view str) {
+        *out++ = '"';
+        out = jsonEscape(str, out);
+        *out++ = '"';
+    }
+
+    template <typename T, size_t... Is>
+    void writeObject(const T& obj, std::index_sequence<Is...>) {
+        if constexpr (sizeof...(Is) == 0) {
+            write("{}");
+        } else {
+            ((write(JsonKey<T, Is>::value), writeValue(obj.*std::get<Is>(flatFields<T>).ptr)), ...);
+            *out++ = '}';
+        }
+    }
+};
+
+} // namespace detail
+
+template <typename T, typename OutputIt>
+OutputIt writeJson(const T& value, OutputIt out) {
+    detail::JsonWriter<OutputIt> writer{out};
+    writer.writeValue(value);
+    return writer.out;
+}
+
+template <typename T>
+std::string toJsonString(const T& value) {
+    std::string json;
+    writeJson(value, std::back_inserter(json));
+    return json;
+}
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
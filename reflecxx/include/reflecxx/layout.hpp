@@ -0,0 +1,229 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Memory layout of reflecxx visitable types.
+// reflecxx::layout<T>() describes every visitable field of T, including those of base classes, in visitation order:
+// its name, offset within T, size, alignment and the kind of its type. Offsets of inherited fields are relative to the
+// start of T, not of the base class. reflecxx::paddingBytes<T>() counts the bytes of T that belong to nothing, and
+// reflecxx::unreflectedBytes<T>() those that belong to something that isn't visitable.
+// Everything is known at compile time, without creating a T. The generated code takes the offsets of a type's own
+// fields with offsetof where T is standard layout, and otherwise from the generator, which lays out the fields the way
+// the compiler does for the target. Base classes of a standard layout type start at its beginning, but where else they
+// are placed isn't known to the generator, so the offsets of inherited fields of other types are unknown.
+
+namespace reflecxx {
+
+// The kind of type of a field.
+enum class FieldKind : uint8_t {
+    Arithmetic,
+    Enum,
+    Pointer,
+    // C-style array or std::array.
+    Array,
+    // A reflecxx visitable class.
+    Reflected,
+    // Any other class.
+    Class,
+    Other,
+};
+
+struct FieldLayout {
+    std::string_view name;
+    // Empty where it isn't known, for fields inherited by a type that isn't standard layout.
+    std::optional<size_t> offset;
+    size_t size;
+    size_t alignment;
+    FieldKind kind;
+};
+
+// Returns the kind of type T.
+template <typename T>
+constexpr FieldKind fieldKind();
+
+// Returns the layout of each visitable field of T, in visitation order.
+template <typename T>
+constexpr const std::array<FieldLayout, fieldCount<T>()>& layout();
+
+// Returns the number of padding bytes of T: bytes that belong to no field, base class or vtable pointer.
+// Visitable fields of visitable type, and arrays of them, contribute their own padding bytes.
+template <typename T>
+constexpr size_t paddingBytes();
+
+// Returns the number of bytes of T used by anything that isn't visitable: fields of non-visitable base classes, vtable
+// pointers, and private and protected fields of classes that don't declare REFLECXX_FRIEND.
+// Visitable fields of visitable type, and arrays of them, contribute their own unreflected bytes. Types whose metadata
+// wasn't generated have none, and their unreflected bytes count as padding instead.
+template <typename T>
+constexpr size_t unreflectedBytes();
+
+namespace detail {
+
+// True if the generated metadata of T includes the offsets of its own fields and its unreflected bytes.
+template <typename T, typename = void>
+struct has_generated_layout : std::false_type {};
+template <typename T>
+struct has_generated_layout<
+    T, std::void_t<decltype(MetaStruct<T>::template fieldOffsets<>()), decltype(MetaStruct<T>::unreflectedBytes)>>
+: std::true_type {};
+
+template <typename T>
+constexpr auto fieldOffsets();
+
+// Copies the offsets of the fields of base class B into those of T, starting at index i.
+template <typename T, typename B, size_t N>
+constexpr void appendBaseOffsets(std::array<std::optional<size_t>, N>& offsets, size_t& i) {
+    for (const auto& offset : fieldOffsets<B>()) {
+        // A standard layout object has the same address as each of its base class subobjects.
+        if constexpr (std::is_standard_layout_v<T>) {
+            offsets[i] = offset;
+        }
+        ++i;
+    }
+}
+
+template <typename T, size_t... Is>
+constexpr auto fieldOffsets(std::index_sequence<Is...>) {
+    std::array<std::optional<size_t>, fieldCount<T>()> offsets{};
+    size_t i = 0;
+    if constexpr (has_generated_layout<T>::value) {
+        for (const size_t offset : MetaStruct<T>::template fieldOffsets<>()) {
+            offsets[i++] = std::optional<size_t>{offset};
+        }
+    } else {
+        i += std::tuple_size_v<std::remove_const_t<decltype(ownFields<T>)>>;
+    }
+    (appendBaseOffsets<T, typename std::tuple_element_t<Is, decltype(MetaStruct<T>::baseClasses)>::type>(offsets, i),
+     ...);
+    return offsets;
+}
+
+// Returns the offset within T of each field of flatFields<T>, where known.
+template <typename T>
+constexpr auto fieldOffsets() {
+    return fieldOffsets<T>(std::make_index_sequence<std::tuple_size_v<decltype(MetaStruct<T>::baseClasses)>>{});
+}
+
+template <typename T, typename M>
+constexpr FieldLayout makeFieldLayout(const ClassMember<T, M>& member, std::optional<size_t> offset) {
+    return {member.name, offset, sizeof(M), alignof(M), fieldKind<M>()};
+}
+
+template <typename T, size_t... Is>
+constexpr std::array<FieldLayout, sizeof...(Is)> makeFieldLayouts(std::index_sequence<Is...>) {
+    constexpr auto offsets = fieldOffsets<T>();
+    return {makeFieldLayout(std::get<Is>(flatFields<T>), offsets[Is])...};
+}
+
+template <typename T>
+inline constexpr auto fieldLayouts = makeFieldLayouts<T>(std::make_index_sequence<fieldCount<T>()>{});
+
+// Bytes of a value that belong to nothing, and to something that isn't visitable.
+struct ByteCounts {
+    size_t padding;
+    size_t unreflected;
+};
+
+template <typename T>
+constexpr ByteCounts byteCounts();
+
+// Bytes used by whatever T itself doesn't reflect, not counting its base classes or fields.
+template <typename T>
+constexpr size_t ownUnreflectedBytes() {
+    if constexpr (has_generated_layout<T>::value) {
+        return MetaStruct<T>::unreflectedBytes;
+    } else {
+        return 0;
+    }
+}
+
+template <typename T, typename M>
+constexpr void addFieldByteCounts(ByteCounts& counts, const ClassMember<T, M>&) {
+    constexpr auto field = byteCounts<M>();
+    counts.padding -= sizeof(M) - field.padding;
+    counts.unreflected += field.unreflected;
+}
+
+template <typename T>
+constexpr ByteCounts byteCounts() {
+    if constexpr (std::is_array_v<T>) {
+        constexpr auto element = byteCounts<std::remove_extent_t<T>>();
+        return {std::extent_v<T> * element.padding, std::extent_v<T> * element.unreflected};
+    } else if constexpr (is_std_array<T>::value) {
+        constexpr auto element = byteCounts<typename T::value_type>();
+        return {std::tuple_size_v<T> * element.padding, std::tuple_size_v<T> * element.unreflected};
+    } else if constexpr (std::is_class_v<T> && is_reflecxx_visitable_v<T>) {
+        // T's own unreflected bytes and those of each of its visitable base classes, then whatever the fields don't
+        // use is padding.
+        constexpr size_t unreflected = std::apply(
+            [](auto... baseTags) {
+                return (ownUnreflectedBytes<T>() + ... + ownUnreflectedBytes<typename decltype(baseTags)::type>());
+            },
+            getBases<T>());
+        ByteCounts counts{sizeof(T) - unreflected, unreflected};
+        std::apply([&counts](const auto&... members) { (addFieldByteCounts(counts, members), ...); }, flatFields<T>);
+        return counts;
+    } else {
+        return {0, 0};
+    }
+}
+
+} // namespace detail
+
+template <typename T>
+constexpr FieldKind fieldKind() {
+    if constexpr (std::is_arithmetic_v<T>) {
+        return FieldKind::Arithmetic;
+    } else if constexpr (std::is_enum_v<T>) {
+        return FieldKind::Enum;
+    } else if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+        return FieldKind::Pointer;
+    } else if constexpr (std::is_array_v<T> || detail::is_std_array<T>::value) {
+        return FieldKind::Array;
+    } else if constexpr (std::is_class_v<T> && is_reflecxx_visitable_v<T>) {
+        return FieldKind::Reflected;
+    } else if constexpr (std::is_class_v<T> || std::is_union_v<T>) {
+        return FieldKind::Class;
+    } else {
+        return FieldKind::Other;
+    }
+}
+
+template <typename T>
+constexpr const std::array<FieldLayout, fieldCount<T>()>& layout() {
+    static_assert(is_reflecxx_visitable_v<T>, "reflecxx::layout requires a reflecxx visitable type!");
+    return detail::fieldLayouts<T>;
+}
+
+template <typename T>
+constexpr size_t paddingBytes() {
+    static_assert(is_reflecxx_visitable_v<T>, "reflecxx::paddingBytes requires a reflecxx visitable type!");
+    return detail::byteCounts<T>().padding;
+}
+
+template <typename T>
+constexpr size_t unreflectedBytes() {
+    static_assert(is_reflecxx_visitable_v<T>, "reflecxx::unreflectedBytes requires a reflecxx visitable type!");
+    return detail::byteCounts<T>().unreflected;
+}
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
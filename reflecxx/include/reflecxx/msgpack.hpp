@@ -0,0 +1,660 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/enum_visitor.hpp>
+#include <reflecxx/flags.hpp>
+#include <reflecxx/span.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// MessagePack (https://msgpack.org) serialization of reflecxx visitable types, without any dependency on a MessagePack
+// library. Structs are written as maps from field keys to values, so the data describes itself and can be read into a
+// different version of the struct: fields missing from the data keep their current values, and unknown keys are
+// skipped. Keys are the field names, or with MsgPackKeys::Indices the positions of the fields in visitation order,
+// which is more compact but only tolerates appending fields. Either way the encoded keys are precomputed at compile
+// time, so writing a key is a single copy. The reader accepts both kinds of keys.
+// Integers are written in the smallest encoding that holds their value, and can be read into any type that holds the
+// value. Reflected enums are written as their enumerator names, and reflecxx::flags as a string of enumerator names
+// separated by '|', or as numbers with MsgPackKeys::Indices. Both are read from either. Empty optionals are written as
+// nil, strings as strings, and C-style arrays, std::arrays and other iterable containers as arrays. Char arrays are
+// arrays of integers too, since they may hold NUL bytes.
+
+namespace reflecxx {
+
+// How the fields of structs are keyed.
+enum class MsgPackKeys {
+    // By field name.
+    Names,
+    // By the index of the field in visitation order, including inherited fields. Enums and flags are also written as
+    // numbers.
+    Indices,
+};
+
+// Writes value as MessagePack to out, an output iterator of std::byte. Returns the output iterator one past the last
+// byte written.
+template <MsgPackKeys Keys = MsgPackKeys::Names, typename T, typename OutputIt>
+OutputIt writeMsgPack(const T& value, OutputIt out);
+
+// Returns value as MessagePack.
+template <MsgPackKeys Keys = MsgPackKeys::Names, typename T>
+std::vector<std::byte> toMsgPack(const T& value);
+
+// Reads the MessagePack data into value. Throws std::runtime_error if the data is malformed or doesn't match the
+// structure of T.
+template <typename T>
+void readMsgPack(span<const std::byte> data, T& value);
+
+// Returns a T read from the MessagePack data. Fields missing from the data are value initialized.
+template <typename T>
+T fromMsgPack(span<const std::byte> data);
+
+namespace detail {
+
+template <size_t Size, typename OutputIt>
+constexpr OutputIt writeBigEndian(uint64_t value, OutputIt out) {
+    for (size_t i = Size; i-- > 0;) {
+        *out++ = static_cast<std::byte>(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    return out;
+}
+
+constexpr size_t msgPackUintSize(uint64_t value) {
+    return value < 0x80 ? 1 : value <= UINT8_MAX ? 2 : value <= UINT16_MAX ? 3 : value <= UINT32_MAX ? 5 : 9;
+}
+
+// Writes value in the smallest unsigned integer format that holds it.
+template <typename OutputIt>
+constexpr OutputIt writeMsgPackUint(uint64_t value, OutputIt out) {
+    if (value < 0x80) {
+        return writeBigEndian<1>(value, out); // positive fixint
+    } else if (value <= UINT8_MAX) {
+        return writeBigEndian<1>(value, writeBigEndian<1>(0xcc, out));
+    } else if (value <= UINT16_MAX) {
+        return writeBigEndian<2>(value, writeBigEndian<1>(0xcd, out));
+    } else if (value <= UINT32_MAX) {
+        return writeBigEndian<4>(value, writeBigEndian<1>(0xce, out));
+    }
+    return writeBigEndian<8>(value, writeBigEndian<1>(0xcf, out));
+}
+
+// Writes value in the smallest integer format that holds it.
+template <typename OutputIt>
+constexpr OutputIt writeMsgPackInt(int64_t value, OutputIt out) {
+    const auto bits = static_cast<uint64_t>(value);
+    if (value >= 0) {
+        return writeMsgPackUint(bits, out);
+    } else if (value >= -32) {
+        return writeBigEndian<1>(bits, out); // negative fixint
+    } else if (value >= INT8_MIN) {
+        return writeBigEndian<1>(bits, writeBigEndian<1>(0xd0, out));
+    } else if (value >= INT16_MIN) {
+        return writeBigEndian<2>(bits, writeBigEndian<1>(0xd1, out));
+    } else if (value >= INT32_MIN) {
+        return writeBigEndian<4>(bits, writeBigEndian<1>(0xd2, out));
+    }
+    return writeBigEndian<8>(bits, writeBigEndian<1>(0xd3, out));
+}
+
+constexpr size_t msgPackStringHeaderSize(size_t size) {
+    return size < 32 ? 1 : size <= UINT8_MAX ? 2 : size <= UINT16_MAX ? 3 : 5;
+}
+
+template <typename OutputIt>
+constexpr OutputIt writeMsgPackStringHeader(size_t size, OutputIt out) {
+    if (size < 32) {
+        return writeBigEndian<1>(0xa0 | size, out); // fixstr
+    } else if (size <= UINT8_MAX) {
+        return writeBigEndian<1>(size, writeBigEndian<1>(0xd9, out));
+    } else if (size <= UINT16_MAX) {
+        return writeBigEndian<2>(size, writeBigEndian<1>(0xda, out));
+    }
+    return writeBigEndian<4>(size, writeBigEndian<1>(0xdb, out));
+}
+
+// Writes the header of an array or a map of size elements. Small sizes are stored in the low nibble of fixTag, larger
+// ones after tag16, or after the tag following it for 32 bit sizes.
+template <typename OutputIt>
+constexpr OutputIt writeMsgPackContainerHeader(size_t size, uint8_t fixTag, uint8_t tag16, OutputIt out) {
+    if (size < 16) {
+        return writeBigEndian<1>(fixTag | size, out);
+    } else if (size <= UINT16_MAX) {
+        return writeBigEndian<2>(size, writeBigEndian<1>(tag16, out));
+    }
+    return writeBigEndian<4>(size, writeBigEndian<1>(tag16 + 1, out));
+}
+
+// The encoded key of the I'th field of T. Computed at compile time, so writing a key is a single copy.
+template <typename T, size_t I, MsgPackKeys Keys>
+struct MsgPackKey {
+    static constexpr std::string_view name = std::get<I>(flatFields<T>).name;
+    static constexpr auto bytes = [] {
+        if constexpr (Keys == MsgPackKeys::Names) {
+            std::array<std::byte, msgPackStringHeaderSize(name.size()) + name.size()> key{};
+            auto it = writeMsgPackStringHeader(name.size(), key.begin());
+            for (const char c : name) {
+                *it++ = static_cast<std::byte>(c);
+            }
+            return key;
+        } else {
+            std::array<std::byte, msgPackUintSize(I)> key{};
+            writeMsgPackUint(I, key.begin());
+            return key;
+        }
+    }();
+};
+
+// Writes MessagePack to an output iterator.
+template <MsgPackKeys Keys, typename OutputIt>
+struct MsgPackWriter {
+    explicit MsgPackWriter(OutputIt out)
+    : out(out) {}
+
+    template <typename T>
+    void writeValue(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            writeByte(value ? 0xc3 : 0xc2);
+        } else if constexpr (std::is_enum_v<T>) {
+            if constexpr (Keys == MsgPackKeys::Names && is_reflecxx_visitable_v<T>) {
+                if (const auto name = tryEnumName(value); !name.empty()) {
+                    writeString(name);
+                    return;
+                }
+            }
+            writeInteger(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            if constexpr (sizeof(T) == sizeof(float)) {
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                out = writeBigEndian<4>(bits, writeBigEndian<1>(0xca, out));
+            } else {
+                const auto d = static_cast<double>(value);
+                uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                out = writeBigEndian<8>(bits, writeBigEndian<1>(0xcb, out));
+            }
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            writeInteger(value);
+        } else if constexpr (!std::is_array_v<T> && std::is_convertible_v<const T&, std::string_view>) {
+            writeString(value);
+        } else if constexpr (is_optional<T>::value) {
+            if (value) {
+                writeValue(*value);
+            } else {
+                writeByte(0xc0);
+            }
+        } else if constexpr (is_flags<T>::value) {
+            if constexpr (Keys == MsgPackKeys::Names) {
+                flagNames.clear();
+                writeFlags(value, std::back_inserter(flagNames));
+                writeString(flagNames);
+            } else {
+                writeInteger(value.bits());
+            }
+        } else if constexpr (is_reflecxx_visitable_v<T>) {
+            writeObject(value, std::make_index_sequence<fieldCount<T>()>{});
+        } else {
+            static_assert(is_iterable<T>::value, "Type is not supported by MessagePack serialization!");
+            out = writeMsgPackContainerHeader(std::size(value), 0x90, 0xdc, out);
+            for (const auto& item : value) {
+                writeValue(item);
+            }
+        }
+    }
+
+    OutputIt out;
+
+ private:
+    void writeByte(uint8_t byte) { *out++ = static_cast<std::byte>(byte); }
+
+    template <typename T>
+    void writeInteger(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            out = writeMsgPackInt(value, out);
+        } else {
+            out = writeMsgPackUint(value, out);
+        }
+    }
+
+    void writeString(std::string_view str) {
+        out = writeMsgPackStringHeader(str.size(), out);
+        out = std::transform(str.begin(), str.end(), out, [](char c) { return static_cast<std::byte>(c); });
+    }
+
+    template <typename T, size_t... Is>
+    void writeObject(const T& obj, std::index_sequence<Is...>) {
+        out = writeMsgPackContainerHeader(sizeof...(Is), 0x80, 0xde, out);
+        ((out = std::copy(MsgPackKey<T, Is, Keys>::bytes.begin(), MsgPackKey<T, Is, Keys>::bytes.end(), out),
+          writeValue(obj.*std::get<Is>(flatFields<T>).ptr)),
+         ...);
+    }
+
+    // Storage for formatting flags, whose length must be known before they're written.
+    std::string flagNames;
+};
+
+// An integer of any width. Negative values are held in two's complement.
+struct MsgPackInteger {
+    uint64_t bits;
+    bool negative;
+};
+
+// Reads MessagePack from a contiguous buffer.
+struct MsgPackReader {
+    MsgPackReader(span<const std::byte> data)
+    : begin(data.data())
+    , pos(data.data())
+    , end(data.data() + data.size()) {}
+
+    template <typename T>
+    void readValue(T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            const auto tag = next();
+            if (tag != 0xc2 && tag != 0xc3) {
+                failAt(pos - 1, "expected a boolean");
+            }
+            value = tag == 0xc3;
+        } else if constexpr (std::is_enum_v<T>) {
+            if constexpr (is_reflecxx_visitable_v<T>) {
+                if (isString(peek())) {
+                    const auto name = readString();
+                    if (const auto e = tryFromName<T>(name)) {
+                        value = *e;
+                        return;
+                    }
+                    fail("no enumerator for name " + std::string{name});
+                }
+            }
+            std::underlying_type_t<T> number{};
+            readNumber(number);
+            value = static_cast<T>(number);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            readNumber(value);
+        } else if constexpr (is_string<T>::value) {
+            value = readString();
+        } else if constexpr (is_optional<T>::value) {
+            if (peek() == 0xc0) {
+                ++pos;
+                value.reset();
+            } else {
+                readValue(value.emplace());
+            }
+        } else if constexpr (is_flags<T>::value) {
+            if (isString(peek())) {
+                const auto str = readString();
+                if (const auto f = tryFlagsFromString<typename T::enum_type>(str)) {
+                    value = *f;
+                    return;
+                }
+                fail("no flags for string " + std::string{str});
+            }
+            typename T::bits_type bits{};
+            readNumber(bits);
+            value = T::fromBits(bits);
+        } else if constexpr (is_reflecxx_visitable_v<T>) {
+            readObject(value, std::make_index_sequence<fieldCount<T>()>{});
+        } else if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+            // Fixed size arrays must match exactly.
+            const auto* start = pos;
+            if (readContainerHeader(0x90, 0xdc, "an array") != std::size(value)) {
+                failAt(start, "array size mismatch");
+            }
+            for (auto& item : value) {
+                readValue(item);
+            }
+        } else {
+            static_assert(is_emplace_back_container<T>::value, "Type is not supported by MessagePack deserialization!");
+            value.clear();
+            for (auto size = readContainerHeader(0x90, 0xdc, "an array"); size > 0; --size) {
+                readValue(value.emplace_back());
+            }
+        }
+    }
+
+    // Checks that nothing follows the value read.
+    void finish() {
+        if (pos != end) {
+            fail("unexpected trailing bytes");
+        }
+    }
+
+ private:
+    template <typename T, size_t... Is>
+    void readObject(T& obj, std::index_sequence<Is...>) {
+        constexpr size_t n = sizeof...(Is);
+        // Index of the field expected next if keys are in declaration order.
+        size_t next = 0;
+
+        for (auto size = readContainerHeader(0x80, 0xde, "a map"); size > 0; --size) {
+            auto i = npos;
+            if (isString(peek())) {
+                [[maybe_unused]] const auto key = readString();
+                if constexpr (n > 0) {
+                    constexpr auto& names = fieldNames<T>;
+                    i = next < n && names[next] == key ? next : fieldNameHash<T>.find(key);
+                    if (names[i] != key) {
+                        i = npos;
+                    }
+                }
+            } else if (isInteger(peek())) {
+                const auto key = readInteger();
+                if (!key.negative && key.bits < n) {
+                    i = static_cast<size_t>(key.bits);
+                }
+            } else {
+                fail("expected a field name or index");
+            }
+
+            if constexpr (n > 0) {
+                // Jump table from runtime field index to the reader for that field's type.
+                using FieldReader = void (*)(MsgPackReader&, T&);
+                static constexpr std::array<FieldReader, n> readers{{[](MsgPackReader& reader, T& o) {
+                    reader.readValue(o.*std::get<Is>(flatFields<T>).ptr);
+                }...}};
+                if (i != npos) {
+                    readers[i](*this, obj);
+                    next = i + 1;
+                    continue;
+                }
+            }
+            skipValue();
+        }
+    }
+
+    template <typename T>
+    void readNumber(T& value) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (peek() == 0xca) {
+                ++pos;
+                const auto bits = static_cast<uint32_t>(readBigEndian<4>());
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                value = static_cast<T>(f);
+                return;
+            }
+            if (peek() == 0xcb) {
+                ++pos;
+                const auto bits = readBigEndian<8>();
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                value = static_cast<T>(d);
+                return;
+            }
+            const auto i = readInteger();
+            value = i.negative ? static_cast<T>(static_cast<int64_t>(i.bits)) : static_cast<T>(i.bits);
+        } else {
+            const auto* start = pos;
+            const auto i = readInteger();
+            if (i.negative) {
+                if (!std::is_signed_v<T> ||
+                    static_cast<int64_t>(i.bits) < static_cast<int64_t>(std::numeric_limits<T>::min())) {
+                    failAt(start, "number out of range");
+                }
+                value = static_cast<T>(static_cast<int64_t>(i.bits));
+            } else {
+                if (i.bits > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                    failAt(start, "number out of range");
+                }
+                value = static_cast<T>(i.bits);
+            }
+        }
+    }
+
+    MsgPackInteger readInteger() {
+        const auto tag = next();
+        if (tag < 0x80) {
+            return {tag, false}; // positive fixint
+        } else if (tag >= 0xe0) {
+            return {static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(tag))), true}; // negative fixint
+        }
+        switch (tag) {
+        case 0xcc:
+            return {readBigEndian<1>(), false};
+        case 0xcd:
+            return {readBigEndian<2>(), false};
+        case 0xce:
+            return {readBigEndian<4>(), false};
+        case 0xcf:
+            return {readBigEndian<8>(), false};
+        case 0xd0:
+            return signedInteger(static_cast<int8_t>(readBigEndian<1>()));
+        case 0xd1:
+            return signedInteger(static_cast<int16_t>(readBigEndian<2>()));
+        case 0xd2:
+            return signedInteger(static_cast<int32_t>(readBigEndian<4>()));
+        case 0xd3:
+            return signedInteger(static_cast<int64_t>(readBigEndian<8>()));
+        default:
+            failAt(pos - 1, "expected an integer");
+        }
+    }
+
+    static MsgPackInteger signedInteger(int64_t value) { return {static_cast<uint64_t>(value), value < 0}; }
+
+    // Returns a view of a string in the input.
+    std::string_view readString() {
+        const auto tag = next();
+        size_t size = 0;
+        if (tag >= 0xa0 && tag <= 0xbf) {
+            size = tag & 0x1f; // fixstr
+        } else if (tag == 0xd9) {
+            size = readBigEndian<1>();
+        } else if (tag == 0xda) {
+            size = readBigEndian<2>();
+        } else if (tag == 0xdb) {
+            size = readBigEndian<4>();
+        } else {
+            failAt(pos - 1, "expected a string");
+        }
+        const auto* start = pos;
+        skip(size);
+        return {reinterpret_cast<const char*>(start), size};
+    }
+
+    // Reads the header of an array or map, returning its number of elements.
+    size_t readContainerHeader(uint8_t fixTag, uint8_t tag16, const char* what) {
+        const auto tag = next();
+        if ((tag & 0xf0) == fixTag) {
+            return tag & 0x0f;
+        } else if (tag == tag16) {
+            return readBigEndian<2>();
+        } else if (tag == tag16 + 1) {
+            return readBigEndian<4>();
+        }
+        failAt(pos - 1, std::string{"expected "} + what);
+    }
+
+    // Skips over a value that doesn't correspond to a field, of any type.
+    void skipValue() {
+        // Number of values left to skip, including the elements of containers that have been entered.
+        uint64_t remaining = 1;
+        for (; remaining > 0; --remaining) {
+            const auto tag = next();
+            if (tag < 0x80 || tag >= 0xe0 || tag == 0xc0 || tag == 0xc2 || tag == 0xc3) {
+                continue; // fixints, nil and booleans
+            } else if (tag < 0x90) {
+                remaining += 2 * (tag & 0x0f); // fixmap
+                continue;
+            } else if (tag < 0xa0) {
+                remaining += tag & 0x0f; // fixarray
+                continue;
+            } else if (tag < 0xc0) {
+                skip(tag & 0x1f); // fixstr
+                continue;
+            }
+            switch (tag) {
+            case 0xc4: // bin 8
+            case 0xd9: // str 8
+                skip(readBigEndian<1>());
+                break;
+            case 0xc5: // bin 16
+            case 0xda: // str 16
+                skip(readBigEndian<2>());
+                break;
+            case 0xc6: // bin 32
+            case 0xdb: // str 32
+                skip(readBigEndian<4>());
+                break;
+            case 0xc7: // ext 8, 16 and 32 have a type byte following the size
+                skip(readBigEndian<1>() + 1);
+                break;
+            case 0xc8:
+                skip(readBigEndian<2>() + 1);
+                break;
+            case 0xc9:
+                skip(readBigEndian<4>() + 1);
+                break;
+            case 0xcc:
+            case 0xd0:
+                skip(1);
+                break;
+            case 0xcd:
+            case 0xd1:
+                skip(2);
+                break;
+            case 0xca:
+            case 0xce:
+            case 0xd2:
+                skip(4);
+                break;
+            case 0xcb:
+            case 0xcf:
+            case 0xd3:
+                skip(8);
+                break;
+            case 0xd4: // fixext 1, 2, 4, 8 and 16, plus a type byte
+                skip(2);
+                break;
+            case 0xd5:
+                skip(3);
+                break;
+            case 0xd6:
+                skip(5);
+                break;
+            case 0xd7:
+                skip(9);
+                break;
+            case 0xd8:
+                skip(17);
+                break;
+            case 0xdc: // array 16
+                remaining += readBigEndian<2>();
+                break;
+            case 0xdd: // array 32
+                remaining += readBigEndian<4>();
+                break;
+            case 0xde: // map 16
+                remaining += 2 * readBigEndian<2>();
+                break;
+            case 0xdf: // map 32
+                remaining += 2 * readBigEndian<4>();
+                break;
+            default:
+                failAt(pos - 1, "invalid type");
+            }
+        }
+    }
+
+    static constexpr bool isString(uint8_t tag) {
+        return (tag >= 0xa0 && tag <= 0xbf) || (tag >= 0xd9 && tag <= 0xdb); // fixstr, str 8, 16 and 32
+    }
+    static constexpr bool isInteger(uint8_t tag) {
+        return tag < 0x80 || tag >= 0xe0 || (tag >= 0xcc && tag <= 0xd3); // fixints, uint and int 8 to 64
+    }
+
+    uint8_t peek() {
+        if (pos == end) {
+            fail("unexpected end of input");
+        }
+        return static_cast<uint8_t>(*pos);
+    }
+
+    uint8_t next() {
+        const auto tag = peek();
+        ++pos;
+        return tag;
+    }
+
+    void skip(uint64_t size) {
+        if (size > static_cast<uint64_t>(end - pos)) {
+            fail("unexpected end of input");
+        }
+        pos += size;
+    }
+
+    template <size_t Size>
+    uint64_t readBigEndian() {
+        const auto* start = pos;
+        skip(Size);
+        uint64_t value = 0;
+        for (size_t i = 0; i < Size; ++i) {
+            value = (value << 8) | static_cast<uint8_t>(start[i]);
+        }
+        return value;
+    }
+
+    [[noreturn]] void fail(const std::string& what) const { failAt(pos, what); }
+
+    [[noreturn]] void failAt(const std::byte* at, const std::string& what) const {
+        throw std::runtime_error{"MessagePack parse error at offset " + std::to_string(at - begin) + ": " + what};
+    }
+
+    const std::byte* begin;
+    const std::byte* pos;
+    const std::byte* end;
+};
+
+} // namespace detail
+
+template <MsgPackKeys Keys, typename T, typename OutputIt>
+OutputIt writeMsgPack(const T& value, OutputIt out) {
+    detail::MsgPackWriter<Keys, OutputIt> writer{out};
+    writer.writeValue(value);
+    return writer.out;
+}
+
+template <MsgPackKeys Keys, typename T>
+std::vector<std::byte> toMsgPack(const T& value) {
+    std::vector<std::byte> data;
+    writeMsgPack<Keys>(value, std::back_inserter(data));
+    return data;
+}
+
+template <typename T>
+void readMsgPack(span<const std::byte> data, T& value) {
+    detail::MsgPackReader reader{data};
+    reader.readValue(value);
+    reader.finish();
+}
+
+template <typename T>
+T fromMsgPack(span<const std::byte> data) {
+    T value{};
+    readMsgPack(data, value);
+    return value;
+}
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
@@ -0,0 +1,288 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/hash.hpp>
+#include <reflecxx/json_reader.hpp>
+#include <reflecxx/json_writer.hpp>
+#include <reflecxx/span.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Field level diff and patch of reflecxx visitable types.
+// reflecxx::diff compares two objects and records the path to, and new value of, every value that differs. Paths
+// descend through nested visitable types, C-style arrays and std::arrays down to leaf values, which are compared with
+// operator==, so a patch only holds what actually changed. reflecxx::apply replays a patch onto another object.
+// Leaf values are encoded in the patch as their native bytes for arithmetic types and enums, and as JSON text for any
+// other type, which must then be supported by reflecxx::writeJson and reflecxx::readJson.
+// A patch can be serialized with patchToBinary, or to JSON through the nlohmann adl_serializer in patch_json.hpp.
+
+namespace reflecxx {
+
+// A single changed value.
+struct PatchEntry {
+    // From the outermost object down to the changed value, the index of a field of a visitable type, as for
+    // reflecxx::get<I>, or of an element of an array.
+    std::vector<uint32_t> path;
+    // The encoded new value.
+    std::string value;
+
+    bool operator==(const PatchEntry& rhs) const { return path == rhs.path && value == rhs.value; }
+    bool operator!=(const PatchEntry& rhs) const { return !(*this == rhs); }
+};
+
+// The changes that turn one T into another.
+template <typename T>
+struct Patch {
+    std::vector<PatchEntry> entries;
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+};
+
+// Returns the patch that, applied to from, makes it equal to to.
+template <typename T>
+Patch<T> diff(const T& from, const T& to);
+
+// Sets each value of obj recorded in patch. Throws std::runtime_error if the patch doesn't match the structure of T.
+template <typename T>
+void apply(T& obj, const Patch<T>& patch);
+
+// Serializes patch into a buffer of bytes, in native byte order.
+template <typename T>
+std::vector<std::byte> patchToBinary(const Patch<T>& patch);
+
+// Deserializes a patch serialized by patchToBinary. Throws std::runtime_error if the bytes are truncated.
+template <typename T>
+Patch<T> patchFromBinary(span<const std::byte> bytes);
+
+namespace detail {
+
+// True if diff stops at values of T rather than descending into them.
+template <typename T>
+inline constexpr bool is_patch_leaf_v =
+    !(std::is_array_v<T> || is_std_array<T>::value || (std::is_class_v<T> && is_reflecxx_visitable_v<T>));
+
+template <typename T>
+void encodePatchValue(const T& value, std::string& out) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        out.assign(reinterpret_cast<const char*>(&value), sizeof(T));
+    } else {
+        writeJson(value, std::back_inserter(out));
+    }
+}
+
+template <typename T>
+void decodePatchValue(std::string_view in, T& value) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        if (in.size() != sizeof(T)) {
+            throw std::runtime_error{"patch value has the wrong size"};
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+            // Any other byte isn't a valid bool representation.
+            if (in[0] != 0 && in[0] != 1) {
+                throw std::runtime_error{"patch value is not a bool"};
+            }
+            value = in[0] == 1;
+        } else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> number{};
+            std::memcpy(&number, in.data(), sizeof(T));
+            value = static_cast<T>(number);
+        } else {
+            std::memcpy(&value, in.data(), sizeof(T));
+        }
+    } else {
+        readJson(in, value);
+    }
+}
+
+template <typename T>
+void diffValue(const T& from, const T& to, std::vector<uint32_t>& path, std::vector<PatchEntry>& out);
+
+template <typename T, size_t... Is>
+void diffFields(const T& from, const T& to, std::vector<uint32_t>& path, std::vector<PatchEntry>& out,
+                std::index_sequence<Is...>) {
+    const auto diffOne = [&](uint32_t i, const auto& member) {
+        path.push_back(i);
+        diffValue(from.*member.ptr, to.*member.ptr, path, out);
+        path.pop_back();
+    };
+    (diffOne(Is, std::get<Is>(flatFields<T>)), ...);
+}
+
+template <typename T>
+void diffValue(const T& from, const T& to, std::vector<uint32_t>& path, std::vector<PatchEntry>& out) {
+    if constexpr (is_patch_leaf_v<T>) {
+        if (!(from == to)) {
+            out.push_back({path, {}});
+            encodePatchValue(to, out.back().value);
+        }
+    } else {
+        // Equal bytes mean equal values, so an unchanged subtree is skipped with a single comparison.
+        if constexpr (is_bytewise_hashable_v<T>) {
+            if (std::memcmp(&from, &to, sizeof(T)) == 0) {
+                return;
+            }
+        }
+        if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+            for (size_t i = 0; i < std::size(from); ++i) {
+                path.push_back(static_cast<uint32_t>(i));
+                diffValue(from[i], to[i], path, out);
+                path.pop_back();
+            }
+        } else {
+            diffFields(from, to, path, out, std::make_index_sequence<fieldCount<T>()>{});
+        }
+    }
+}
+
+// Follows the path [it, end) down from obj, calling f with a pointer to the leaf value it leads to. obj may be null, in
+// which case f is called with a null pointer of the right type, for when only the type of the value is needed.
+template <typename T, typename F>
+void walkPatchPath(T* obj, const uint32_t* it, const uint32_t* end, F& f);
+
+template <typename T, typename F, size_t... Is>
+void walkPatchField(T* obj, const uint32_t* it, const uint32_t* end, F& f, std::index_sequence<Is...>) {
+    using FieldWalker = void (*)(T*, const uint32_t*, const uint32_t*, F&);
+    static constexpr FieldWalker walkers[] = {[](T* o, const uint32_t* i, const uint32_t* e, F& fn) {
+        constexpr auto& member = std::get<Is>(flatFields<T>);
+        walkPatchPath(o ? &(o->*member.ptr) : nullptr, i, e, fn);
+    }...};
+    walkers[*it](obj, it + 1, end, f);
+}
+
+template <typename T, typename F>
+void walkPatchPath(T* obj, const uint32_t* it, const uint32_t* end, F& f) {
+    if (it == end) {
+        if constexpr (is_patch_leaf_v<T>) {
+            f(obj);
+            return;
+        } else {
+            throw std::runtime_error{"patch path ends before reaching a value"};
+        }
+    }
+    if constexpr (std::is_array_v<T> || is_std_array<T>::value) {
+        size_t size = 0;
+        if constexpr (std::is_array_v<T>) {
+            size = std::extent_v<T>;
+        } else {
+            size = std::tuple_size_v<T>;
+        }
+        if (*it >= size) {
+            throw std::runtime_error{"patch path index " + std::to_string(*it) + " is out of range"};
+        }
+        walkPatchPath(obj ? &(*obj)[*it] : nullptr, it + 1, end, f);
+    } else if constexpr (!is_patch_leaf_v<T>) {
+        if (*it >= fieldCount<T>()) {
+            throw std::runtime_error{"patch path index " + std::to_string(*it) + " is out of range"};
+        }
+        if constexpr (fieldCount<T>() > 0) {
+            walkPatchField(obj, it, end, f, std::make_index_sequence<fieldCount<T>()>{});
+        }
+    } else {
+        throw std::runtime_error{"patch path continues past a value"};
+    }
+}
+
+// Calls f with a null pointer to the type of the leaf value at path in a T.
+template <typename T, typename F>
+void visitPatchType(const std::vector<uint32_t>& path, F&& f) {
+    walkPatchPath(static_cast<T*>(nullptr), path.data(), path.data() + path.size(), f);
+}
+
+template <typename T>
+void appendBytes(std::vector<std::byte>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T readBytes(span<const std::byte>& in) {
+    if (in.size() < sizeof(T)) {
+        throw std::runtime_error{"patch data is truncated"};
+    }
+    T value{};
+    std::memcpy(&value, in.data(), sizeof(T));
+    in = in.subspan(sizeof(T));
+    return value;
+}
+
+} // namespace detail
+
+template <typename T>
+Patch<T> diff(const T& from, const T& to) {
+    static_assert(is_reflecxx_visitable_v<T>, "reflecxx::diff requires a reflecxx visitable type!");
+    Patch<T> patch;
+    std::vector<uint32_t> path;
+    detail::diffValue(from, to, path, patch.entries);
+    return patch;
+}
+
+template <typename T>
+void apply(T& obj, const Patch<T>& patch) {
+    for (const auto& entry : patch.entries) {
+        const auto set = [&entry](auto* value) { detail::decodePatchValue(entry.value, *value); };
+        detail::walkPatchPath(&obj, entry.path.data(), entry.path.data() + entry.path.size(), set);
+    }
+}
+
+// Each entry is written as the number of path indices, the indices, the size of the value and its bytes.
+template <typename T>
+std::vector<std::byte> patchToBinary(const Patch<T>& patch) {
+    std::vector<std::byte> out;
+    detail::appendBytes(out, static_cast<uint32_t>(patch.entries.size()));
+    for (const auto& entry : patch.entries) {
+        detail::appendBytes(out, static_cast<uint32_t>(entry.path.size()));
+        const auto* path = reinterpret_cast<const std::byte*>(entry.path.data());
+        out.insert(out.end(), path, path + entry.path.size() * sizeof(uint32_t));
+        detail::appendBytes(out, static_cast<uint32_t>(entry.value.size()));
+        const auto* value = reinterpret_cast<const std::byte*>(entry.value.data());
+        out.insert(out.end(), value, value + entry.value.size());
+    }
+    return out;
+}
+
+template <typename T>
+Patch<T> patchFromBinary(span<const std::byte> bytes) {
+    Patch<T> patch;
+    const auto count = detail::readBytes<uint32_t>(bytes);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& entry = patch.entries.emplace_back();
+        const auto depth = detail::readBytes<uint32_t>(bytes);
+        if (bytes.size() / sizeof(uint32_t) < depth) {
+            throw std::runtime_error{"patch data is truncated"};
+        }
+        entry.path.resize(depth);
+        for (auto& index : entry.path) {
+            index = detail::readBytes<uint32_t>(bytes);
+        }
+        const auto size = detail::readBytes<uint32_t>(bytes);
+        if (bytes.size() < size) {
+            throw std::runtime_error{"patch data is truncated"};
+        }
+        entry.value.assign(reinterpret_cast<const char*>(bytes.data()), size);
+        bytes = bytes.subspan(size);
+    }
+    return patch;
+}
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
@@ -0,0 +1,54 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/json_visitor.hpp>
+#include <reflecxx/patch.hpp>
+
+// Note: This library does not link against/set include dirs for nlohmann json by default!
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// nlohmann JSON serialization of reflecxx::Patch. Kept out of patch.hpp, which doesn't depend on nlohmann json.
+
+namespace nlohmann {
+// Patches are arrays of {"path": [indices...], "value": new value} objects.
+template <typename T>
+struct adl_serializer<reflecxx::Patch<T>> {
+    static void to_json(json& j, const reflecxx::Patch<T>& patch) {
+        j = json::array();
+        for (const auto& entry : patch.entries) {
+            json value;
+            reflecxx::detail::visitPatchType<T>(entry.path, [&](auto* type) {
+                std::remove_pointer_t<decltype(type)> v{};
+                reflecxx::detail::decodePatchValue(entry.value, v);
+                value = v;
+            });
+            j.push_back({{"path", entry.path}, {"value", std::move(value)}});
+        }
+    }
+
+    static void from_json(const json& j, reflecxx::Patch<T>& patch) {
+        patch.entries.clear();
+        for (const auto& item : j) {
+            auto& entry = patch.entries.emplace_back();
+            entry.path = item.at("path").get<std::vector<uint32_t>>();
+            reflecxx::detail::visitPatchType<T>(entry.path, [&](auto* type) {
+                const auto v = item.at("value").get<std::remove_pointer_t<decltype(type)>>();
+                reflecxx::detail::encodePatchValue(v, entry.value);
+            });
+        }
+    }
+};
+} // namespace nlohmann
+
+#endif // REFLECXX_GENERATION
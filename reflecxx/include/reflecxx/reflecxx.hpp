@@ -11,9 +11,22 @@
 #pragma once
 
 // Monolithic include header
-// Note: does not include json_visitor.hpp as this library doesn't link/include nlohmann::json by default.
+// Note: does not include json_visitor.hpp or patch_json.hpp as this library doesn't link/include nlohmann::json by default.
 
 #include <reflecxx/attributes.hpp>
+#include <reflecxx/binary_visitor.hpp>
+#include <reflecxx/columnar.hpp>
+#include <reflecxx/enum_map.hpp>
 #include <reflecxx/enum_visitor.hpp>
+#include <reflecxx/flags.hpp>
+#include <reflecxx/hash.hpp>
+#include <reflecxx/json_reader.hpp>
+#include <reflecxx/json_writer.hpp>
+#include <reflecxx/layout.hpp>
+#include <reflecxx/msgpack.hpp>
+#include <reflecxx/patch.hpp>
+#include <reflecxx/soa_vector.hpp>
+#include <reflecxx/span.hpp>
 #include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/tracked.hpp>
 #include <reflecxx/visit.hpp>
@@ -0,0 +1,335 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/detail/types.hpp>
+#include <reflecxx/span.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace reflecxx {
+
+namespace detail {
+
+// Resets value to its value initialized state, element-wise for C-style arrays.
+template <typename M>
+void resetField(M& value) {
+    if constexpr (std::is_array_v<M>) {
+        for (auto& item : value) {
+            resetField(item);
+        }
+    } else {
+        value = M{};
+    }
+}
+
+template <typename Fields>
+struct SoaColumns;
+template <typename T, typename... Ms>
+struct SoaColumns<std::tuple<ClassMember<T, Ms>...>> {
+    using type = std::tuple<std::unique_ptr<Ms[]>...>;
+};
+
+} // namespace detail
+
+// A sequence of T stored as a struct of arrays: each visitable field of T, including those of base classes, lives in
+// its own contiguous column, in visitation order. Kernels that only touch a few fields of many rows then stream
+// through just those columns, rather than pulling whole objects through the cache.
+// Rows are accessed through proxies which read and write the fields in the columns; a row converts to a T, and can be
+// assigned from one. Only the visitable fields of T are stored, and every field type must be default constructible.
+template <typename T>
+class soa_vector {
+    static_assert(is_reflecxx_visitable_v<T>, "soa_vector requires a reflecxx visitable type!");
+
+    using Fields = detail::remove_cvref_t<decltype(detail::flatFields<T>)>;
+    using Indices = std::make_index_sequence<std::tuple_size_v<Fields>>;
+
+ public:
+    // The type of the elements of the I'th column.
+    template <size_t I>
+    using column_type = typename std::tuple_element_t<I, Fields>::type;
+
+    template <bool IsConst>
+    class Iterator;
+
+    // Proxy for a single row.
+    template <bool IsConst>
+    class Row {
+        using Container = std::conditional_t<IsConst, const soa_vector, soa_vector>;
+
+     public:
+        // A reference to a row converts to a const reference.
+        template <bool C, typename = std::enable_if_t<IsConst && !C>>
+        Row(const Row<C>& other)
+        : container(other.container)
+        , index(other.index) {}
+        Row(const Row&) = default;
+
+        // Returns the I'th field of this row.
+        template <size_t I>
+        auto& get() const {
+            auto& value = std::get<I>(container->columns)[index];
+            if constexpr (IsConst) {
+                return std::as_const(value);
+            } else {
+                return value;
+            }
+        }
+
+        // Returns a copy of this row as a T.
+        operator T() const {
+            T value{};
+            load(value, Indices{});
+            return value;
+        }
+
+        // Assigning to a row assigns to the fields in the columns, rather than rebinding the proxy.
+        const Row& operator=(const T& value) const {
+            static_assert(!IsConst, "Can't assign through a const row!");
+            store(value, Indices{});
+            return *this;
+        }
+        const Row& operator=(const Row& other) const { return assign(other); }
+        template <bool C>
+        const Row& operator=(const Row<C>& other) const {
+            return assign(other);
+        }
+
+     private:
+        friend class soa_vector;
+        template <bool>
+        friend class Row;
+        template <bool>
+        friend class Iterator;
+
+        Row(Container* container, size_t index)
+        : container(container)
+        , index(index) {}
+
+        template <size_t... Is>
+        void load(T& value, std::index_sequence<Is...>) const {
+            (detail::assignField(value.*std::get<Is>(detail::flatFields<T>).ptr, get<Is>()), ...);
+        }
+
+        template <size_t... Is>
+        void store(const T& value, std::index_sequence<Is...>) const {
+            (detail::assignField(get<Is>(), value.*std::get<Is>(detail::flatFields<T>).ptr), ...);
+        }
+
+        template <bool C>
+        const Row& assign(const Row<C>& other) const {
+            static_assert(!IsConst, "Can't assign through a const row!");
+            assignRow(other, Indices{});
+            return *this;
+        }
+
+        template <bool C, size_t... Is>
+        void assignRow(const Row<C>& other, std::index_sequence<Is...>) const {
+            (detail::assignField(get<Is>(), other.template get<Is>()), ...);
+        }
+
+        Container* container;
+        size_t index;
+    };
+
+    // Forward iterator over the rows, dereferencing to row proxies.
+    template <bool IsConst>
+    class Iterator {
+        using Container = std::conditional_t<IsConst, const soa_vector, soa_vector>;
+
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Row<IsConst>;
+
+        reference operator*() const { return {container, index}; }
+
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto prev = *this;
+            ++index;
+            return prev;
+        }
+
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+     private:
+        friend class soa_vector;
+
+        Iterator(Container* container, size_t index)
+        : container(container)
+        , index(index) {}
+
+        Container* container;
+        size_t index;
+    };
+
+    using value_type = T;
+    using size_type = size_t;
+    using reference = Row<false>;
+    using const_reference = Row<true>;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    soa_vector() = default;
+
+    // Constructs a container of count value initialized rows.
+    explicit soa_vector(size_t count) { resize(count); }
+
+    soa_vector(std::initializer_list<T> values) {
+        reserve(values.size());
+        for (const auto& value : values) {
+            push_back(value);
+        }
+    }
+
+    soa_vector(const soa_vector& other) {
+        reserve(other.rows);
+        copyRows(other, Indices{});
+        rows = other.rows;
+    }
+
+    soa_vector(soa_vector&& other) noexcept
+    : columns(std::move(other.columns))
+    , rows(std::exchange(other.rows, 0))
+    , allocated(std::exchange(other.allocated, 0)) {}
+
+    soa_vector& operator=(soa_vector other) noexcept {
+        std::swap(columns, other.columns);
+        std::swap(rows, other.rows);
+        std::swap(allocated, other.allocated);
+        return *this;
+    }
+
+    size_t size() const noexcept { return rows; }
+    size_t capacity() const noexcept { return allocated; }
+    bool empty() const noexcept { return rows == 0; }
+
+    // Allocates room for at least capacity rows in every column.
+    void reserve(size_t capacity) {
+        if (capacity > allocated) {
+            reallocate(capacity, Indices{});
+        }
+    }
+
+    // Grows with value initialized rows, or shrinks, to count rows.
+    void resize(size_t count) {
+        reserve(count);
+        resetRows(count, rows, Indices{});
+        rows = count;
+    }
+
+    void clear() { resize(0); }
+
+    void push_back(const T& value) { emplace_back() = value; }
+
+    // Appends a value initialized row, returning a reference to it.
+    reference emplace_back() {
+        if (rows == allocated) {
+            reallocate(std::max<size_t>(1, 2 * allocated), Indices{});
+        }
+        return {this, rows++};
+    }
+
+    void pop_back() { resize(rows - 1); }
+
+    reference operator[](size_t i) { return {this, i}; }
+    const_reference operator[](size_t i) const { return {this, i}; }
+
+    reference at(size_t i) {
+        checkIndex(i);
+        return {this, i};
+    }
+    const_reference at(size_t i) const {
+        checkIndex(i);
+        return {this, i};
+    }
+
+    reference front() { return {this, 0}; }
+    const_reference front() const { return {this, 0}; }
+    reference back() { return {this, rows - 1}; }
+    const_reference back() const { return {this, rows - 1}; }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, rows}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, rows}; }
+
+    // Returns a view of the contiguous column holding the I'th field of every row.
+    template <size_t I>
+    span<column_type<I>> column() {
+        return {std::get<I>(columns).get(), rows};
+    }
+    template <size_t I>
+    span<const column_type<I>> column() const {
+        return {std::get<I>(columns).get(), rows};
+    }
+
+ private:
+    void checkIndex(size_t i) const {
+        if (i >= rows) {
+            throw std::out_of_range{"soa_vector index out of range"};
+        }
+    }
+
+    template <size_t... Is>
+    void reallocate(size_t capacity, std::index_sequence<Is...>) {
+        // Allocate every column before moving any rows, so a failed allocation leaves the container unchanged.
+        typename detail::SoaColumns<Fields>::type moved{std::make_unique<column_type<Is>[]>(capacity)...};
+        (moveColumn(std::get<Is>(columns).get(), std::get<Is>(moved).get()), ...);
+        columns = std::move(moved);
+        allocated = capacity;
+    }
+
+    template <typename M>
+    void moveColumn(M* from, M* to) {
+        for (size_t i = 0; i < rows; ++i) {
+            detail::assignField(to[i], std::move(from[i]));
+        }
+    }
+
+    // Resets any rows in [first, last), so that rows past the end are always value initialized.
+    template <size_t... Is>
+    void resetRows(size_t first, size_t last, std::index_sequence<Is...>) {
+        for (auto i = first; i < last; ++i) {
+            (detail::resetField(std::get<Is>(columns)[i]), ...);
+        }
+    }
+
+    template <size_t... Is>
+    void copyRows(const soa_vector& other, std::index_sequence<Is...>) {
+        for (size_t i = 0; i < other.rows; ++i) {
+            (detail::assignField(std::get<Is>(columns)[i], std::get<Is>(other.columns)[i]), ...);
+        }
+    }
+
+    typename detail::SoaColumns<Fields>::type columns;
+    size_t rows{};
+    size_t allocated{};
+};
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
@@ -0,0 +1,60 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace reflecxx {
+
+// Non-owning view of a contiguous sequence of T. A minimal stand-in for the C++20 std::span, with dynamic extent only.
+template <typename T>
+class span {
+ public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using iterator = T*;
+
+    constexpr span() noexcept = default;
+
+    constexpr span(T* data, size_t size) noexcept
+    : elements(data)
+    , count(size) {}
+
+    // From any contiguous container or array whose elements are convertible to T, such as C-style arrays, std::array,
+    // std::vector, or a span of non-const elements. As for std::span, temporaries are only accepted for const elements,
+    // so that the result of a function can be passed on as an argument.
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<decltype(std::data(std::declval<Container&>())), T*> &&
+                                          (std::is_lvalue_reference_v<Container> || std::is_const_v<T>)>>
+    constexpr span(Container&& container) noexcept
+    : elements(std::data(container))
+    , count(std::size(container)) {}
+
+    constexpr T* data() const noexcept { return elements; }
+    constexpr size_t size() const noexcept { return count; }
+    constexpr bool empty() const noexcept { return count == 0; }
+
+    constexpr T& operator[](size_t i) const { return elements[i]; }
+    constexpr T& front() const { return elements[0]; }
+    constexpr T& back() const { return elements[count - 1]; }
+
+    constexpr iterator begin() const noexcept { return elements; }
+    constexpr iterator end() const noexcept { return elements + count; }
+
+    // Returns a view of size elements starting at offset, or of the remainder of this span if size is not provided.
+    constexpr span subspan(size_t offset, size_t size = static_cast<size_t>(-1)) const {
+        return {elements + offset, size == static_cast<size_t>(-1) ? count - offset : size};
+    }
+
+ private:
+    T* elements{};
+    size_t count{};
+};
+
+} // namespace reflecxx
@@ -10,6 +10,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 
@@ -38,6 +39,48 @@ using typeAt = typename decltype(getType<I, T>())::type;
 template <size_t I, typename T>
 constexpr auto& get(T& obj);
 
+// Returns the index of the visitable field of T named name, including fields of base classes. Throws
+// std::runtime_error if there is no such field, which is a compilation error in a constant expression. Where a field
+// shadows one of the same name in a base class, the index of the first in visitation order is returned.
+// Used as a template argument, the lookup is resolved entirely at compile time, e.g.
+//   auto& field = reflecxx::get<reflecxx::fieldIndex<T>("name")>(obj);
+template <typename T>
+constexpr size_t fieldIndex(std::string_view name);
+
+// Returns true if T has a visitable field named name, including fields of base classes.
+template <typename T>
+constexpr bool hasField(std::string_view name);
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+// String literal usable as a template argument, where class types are allowed as non-type template parameters (C++20).
+template <size_t N>
+struct fixed_string {
+    constexpr fixed_string(const char (&str)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            chars[i] = str[i];
+        }
+    }
+    constexpr std::string_view view() const { return {chars, N - 1}; }
+
+    char chars[N]{};
+};
+
+// Returns a reference to the field named Name in an instance of T, e.g. reflecxx::get<"name">(obj).
+template <fixed_string Name, typename T>
+constexpr auto& get(T& obj) {
+    return get<fieldIndex<T>(Name.view())>(obj);
+}
+
+// True if T has a visitable field named Name, e.g. reflecxx::has_field_v<T, "name">.
+template <typename T, fixed_string Name>
+inline constexpr bool has_field_v = hasField<T>(Name.view());
+#endif
+
+// Applies visitor to the field of obj named name, as visitor(name, field), using a perfect hash of the field names to
+// find it in constant time. Returns false, without calling visitor, if there is no such field.
+template <typename T, typename Visitor>
+bool getByName(T& obj, std::string_view name, Visitor&& visitor);
+
 // Returns a tuple of type_tags representing the types of the visitable fields of T.
 template <typename T>
 constexpr auto getVisitableTypes();
@@ -58,7 +101,8 @@ constexpr void forEachApply(T&& t1, T&& t2, Visitor&& visitor) {
     applyForEach(std::forward<Visitor>(visitor), std::forward<T>(t1), std::forward<T>(t2));
 }
 
-// Returns the result of applying Operation to each field of lhs and rhs, pairwise, AND'ing the results.
+// Returns the result of applying Operation to each field of lhs and rhs, pairwise, AND'ing the results. Stops at the
+// first field for which op is false.
 template <typename T, typename Operation>
 constexpr bool compare(const T& lhs, const T& rhs, const Operation& op);
 
@@ -68,17 +112,23 @@ constexpr bool equalTo(const T& lhs, const T& rhs) {
     return compare(lhs, rhs, std::equal_to<>{});
 }
 
+// Returns true if each field of lhs is less than or equal to the corresponding field of rhs, and at least one is less.
+// Caution! This is not a lexicographic comparison, and doesn't give a strict weak ordering, so use threeWay for sorting.
 template <typename T>
-constexpr bool lessThan(const T& lhs, const T& rhs) {
-    // Caution! We can't just use std::less, in case just a single field is less and the rest are equal.
-    return compare(lhs, rhs, std::less_equal<>{}) && !equalTo(lhs, rhs);
-}
+constexpr bool lessThan(const T& lhs, const T& rhs);
 
+// Returns true if each field of lhs is greater than or equal to the corresponding field of rhs, and at least one is
+// greater.
 template <typename T>
-constexpr bool greaterThan(const T& lhs, const T& rhs) {
-    // Caution! We can't just use std::greater in case just a single field is greater and the rest are equal.
-    return compare(lhs, rhs, std::greater_equal<>{}) && !equalTo(lhs, rhs);
-}
+constexpr bool greaterThan(const T& lhs, const T& rhs);
+
+// Lexicographic three way comparison of the fields of lhs and rhs, in visitation order, stopping at the first that
+// differs. Nested visitable types and arrays are compared lexicographically as well; other fields need operator<.
+// The result compares to 0 the way lhs compares to rhs, e.g. for sorting:
+//   std::sort(begin, end, [](const auto& a, const auto& b) { return reflecxx::threeWay(a, b) < 0; });
+// It is a std::weak_ordering where available (C++20), otherwise an int.
+template <typename T>
+constexpr auto threeWay(const T& lhs, const T& rhs);
 
 } // namespace reflecxx
 
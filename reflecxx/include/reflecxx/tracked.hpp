@@ -0,0 +1,213 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+// The code below uses the generated visitor acceptors. To avoid problems if this header is included into headers that
+// get compiled by the generator, don't define it during generation.
+#ifndef REFLECXX_GENERATION
+
+#include <reflecxx/binary_visitor.hpp>
+#include <reflecxx/detail/types.hpp>
+#include <reflecxx/json_reader.hpp>
+#include <reflecxx/json_writer.hpp>
+#include <reflecxx/span.hpp>
+#include <reflecxx/struct_visitor.hpp>
+#include <reflecxx/visit.hpp>
+
+#include <bitset>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Dirty tracking of the fields of reflecxx visitable types, for incremental serialization.
+// A tracked<T> owns a T and only allows its fields to be written through accessors that record which fields were
+// written, indexed as for reflecxx::get<I>. The dirty serializers below then write just those fields and clear their
+// bits, so only what changed since the last serialization is sent, without keeping and diffing a previous copy.
+
+namespace reflecxx {
+
+template <typename T>
+class tracked {
+    static_assert(is_reflecxx_visitable_v<T>, "tracked requires a reflecxx visitable type!");
+
+ public:
+    using dirty_set = std::bitset<fieldCount<T>()>;
+
+    tracked() = default;
+    // Every field of value starts out clean.
+    explicit tracked(T value)
+    : object(std::move(value)) {}
+
+    const T& value() const { return object; }
+
+    // Returns the I'th field.
+    template <size_t I>
+    const auto& get() const {
+        return reflecxx::get<I>(object);
+    }
+
+    // Assigns value to the I'th field and marks it dirty. The field is marked even if the value is unchanged.
+    template <size_t I, typename V>
+    void set(V&& value) {
+        detail::assignField(reflecxx::get<I>(object), std::forward<V>(value));
+        dirty.set(I);
+    }
+
+    // Marks the I'th field dirty and returns a mutable reference to it, for modifying it in place.
+    template <size_t I>
+    auto& modify() {
+        dirty.set(I);
+        return reflecxx::get<I>(object);
+    }
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+    // As above, for the field named Name, e.g. t.set<"name">(value).
+    template <fixed_string Name>
+    const auto& get() const {
+        return get<fieldIndex<T>(Name.view())>();
+    }
+    template <fixed_string Name, typename V>
+    void set(V&& value) {
+        set<fieldIndex<T>(Name.view())>(std::forward<V>(value));
+    }
+    template <fixed_string Name>
+    auto& modify() {
+        return modify<fieldIndex<T>(Name.view())>();
+    }
+#endif
+
+    bool isDirty(size_t i) const { return dirty.test(i); }
+    bool anyDirty() const { return dirty.any(); }
+    const dirty_set& dirtyFields() const { return dirty; }
+
+    // Marks every field dirty, e.g. to send a complete snapshot.
+    void markAllDirty() { dirty.set(); }
+    void clearDirty() { dirty.reset(); }
+
+ private:
+    T object{};
+    dirty_set dirty;
+};
+
+// Writes the dirty fields of value as a JSON object to out, then marks them clean. Returns the output iterator one
+// past the last character written. The object can be applied to a T with reflecxx::readJsonFields.
+template <typename T, typename OutputIt>
+OutputIt writeDirtyJson(tracked<T>& value, OutputIt out);
+
+// Returns the dirty fields of value as a JSON object, then marks them clean.
+template <typename T>
+std::string toDirtyJson(tracked<T>& value);
+
+// Serializes the dirty fields of value, then marks them clean. The bytes are a bitmask of the dirty fields, one bit per
+// field in visitation order, followed by the binary serialization of each dirty field, as for reflecxx::toBinary.
+template <typename T>
+std::vector<std::byte> toDirtyBinary(tracked<T>& value);
+
+// Deserializes the fields serialized by toDirtyBinary into value, leaving the others unchanged. Throws
+// std::runtime_error if the bytes are truncated.
+template <typename T>
+void fromDirtyBinary(span<const std::byte> bytes, T& value);
+
+namespace detail {
+
+template <typename T>
+inline constexpr size_t dirty_mask_size_v = (fieldCount<T>() + 7) / 8;
+
+template <typename T, typename OutputIt, size_t... Is>
+OutputIt writeDirtyFields(const T& obj, const typename tracked<T>::dirty_set& dirty, OutputIt out,
+                          std::index_sequence<Is...>) {
+    JsonWriter<OutputIt> writer{out};
+    *writer.out++ = '{';
+    bool first = true;
+    const auto writeOne = [&](auto key, const auto& field) {
+        // Skip the precomputed separator, since the first dirty field needn't be the first field.
+        if (!first) {
+            *writer.out++ = ',';
+        }
+        first = false;
+        writer.write(key.substr(1));
+        writer.writeValue(field);
+    };
+    ((dirty[Is] ? writeOne(JsonKey<T, Is>::value, obj.*std::get<Is>(flatFields<T>).ptr) : void()), ...);
+    *writer.out++ = '}';
+    return writer.out;
+}
+
+template <typename T, size_t... Is>
+size_t dirtyBinarySize(const typename tracked<T>::dirty_set& dirty, std::index_sequence<Is...>) {
+    return (size_t{0} + ... + (dirty[Is] ? binarySize<typeAt<Is, T>>() : 0));
+}
+
+} // namespace detail
+
+template <typename T, typename OutputIt>
+OutputIt writeDirtyJson(tracked<T>& value, OutputIt out) {
+    out = detail::writeDirtyFields(value.value(), value.dirtyFields(), out,
+                                   std::make_index_sequence<fieldCount<T>()>{});
+    value.clearDirty();
+    return out;
+}
+
+template <typename T>
+std::string toDirtyJson(tracked<T>& value) {
+    std::string json;
+    writeDirtyJson(value, std::back_inserter(json));
+    return json;
+}
+
+template <typename T>
+std::vector<std::byte> toDirtyBinary(tracked<T>& value) {
+    constexpr auto indices = std::make_index_sequence<fieldCount<T>()>{};
+    const auto& dirty = value.dirtyFields();
+    std::vector<std::byte> bytes(detail::dirty_mask_size_v<T> + detail::dirtyBinarySize<T>(dirty, indices));
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        if (dirty[i]) {
+            bytes[i / 8] |= std::byte{1} << (i % 8);
+        }
+    }
+    ToBinaryVisitor v{bytes.data() + detail::dirty_mask_size_v<T>};
+    std::apply(
+        [&](const auto&... members) {
+            size_t i = 0;
+            ((dirty[i++] ? v(members.name, value.value().*members.ptr) : void()), ...);
+        },
+        detail::flatFields<T>);
+    v.flush();
+    value.clearDirty();
+    return bytes;
+}
+
+template <typename T>
+void fromDirtyBinary(span<const std::byte> bytes, T& value) {
+    static_assert(is_reflecxx_visitable_v<T>, "fromDirtyBinary requires a reflecxx visitable type!");
+    constexpr size_t maskSize = detail::dirty_mask_size_v<T>;
+    if (bytes.size() < maskSize) {
+        throw std::runtime_error{"dirty field data is truncated"};
+    }
+    typename tracked<T>::dirty_set dirty;
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        dirty[i] = (bytes[i / 8] & (std::byte{1} << (i % 8))) != std::byte{0};
+    }
+    if (bytes.size() - maskSize < detail::dirtyBinarySize<T>(dirty, std::make_index_sequence<fieldCount<T>()>{})) {
+        throw std::runtime_error{"dirty field data is truncated"};
+    }
+    FromBinaryVisitor v{bytes.data() + maskSize};
+    std::apply(
+        [&](const auto&... members) {
+            size_t i = 0;
+            ((dirty[i++] ? v(members.name, value.*members.ptr) : void()), ...);
+        },
+        detail::flatFields<T>);
+    v.flush();
+}
+
+} // namespace reflecxx
+
+#endif // REFLECXX_GENERATION
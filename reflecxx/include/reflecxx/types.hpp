@@ -7,6 +7,7 @@
 #include <reflecxx/detail/types.hpp>
 
 #include <string_view>
+#include <type_traits>
 
 namespace reflecxx {
 
@@ -46,7 +47,12 @@ struct MetaStruct : detail::MetaStructInternal<T> {
     // Expected interface:
     // static constexpr std::string_view name{"T"};
     // static constexpr auto publicFields = std::make_tuple(/*std::tuple of ClassMembers*/);
+    // Only for classes declaring REFLECXX_FRIEND:
+    // static constexpr auto privateFields = std::make_tuple(/*std::tuple of ClassMembers*/);
     // static constexpr auto baseClasses = std::make_tuple(/*std::tuple of type_tag*/);
+    // Optional, used by layout.hpp:
+    // template <typename U = T> static constexpr std::array<size_t, N> fieldOffsets(); // Of the reflected own fields.
+    // static constexpr size_t unreflectedBytes{/*unreflected base classes, private fields and vtable pointer*/};
 };
 template <typename T>
 struct MetaEnum : detail::MetaEnumInternal<T> {
@@ -70,4 +76,16 @@ struct ClassMember {
     std::string_view name;
 };
 
+// Returns the name of the struct or enum type T. The returned view never expires.
+// Shared by the struct and enum visitors so that both can be included together.
+template <typename T>
+constexpr std::string_view getName() {
+    using CleanT = detail::remove_cvref_t<T>;
+    if constexpr (std::is_enum_v<CleanT>) {
+        return MetaEnum<CleanT>::name;
+    } else {
+        return MetaStruct<CleanT>::name;
+    }
+}
+
 } // namespace reflecxx
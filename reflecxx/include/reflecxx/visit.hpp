@@ -17,36 +17,35 @@ template <typename T, typename V>
 constexpr void visit(T&& instance, V&& visitor) {
     // wrap visitor in something that binds member pointers
     using CleanT = detail::remove_cvref_t<T>;
-    detail::forEach(MetaStruct<CleanT>::publicFields, detail::MemberVisitor<T, V>{instance, visitor});
+    detail::forEach(detail::ownFields<CleanT>, detail::MemberVisitor<T, V>{instance, visitor});
     detail::forEach(MetaStruct<CleanT>::baseClasses, detail::BaseClassMemberVisitor<T, V>{instance, visitor});
 }
 
 template <typename T, typename V>
 constexpr void visit(V&& visitor) {
     using CleanT = detail::remove_cvref_t<T>;
-    detail::forEach(MetaStruct<CleanT>::publicFields, detail::MemberTypeVisitor<V>{visitor});
+    detail::forEach(detail::ownFields<CleanT>, detail::MemberTypeVisitor<V>{visitor});
     detail::forEach(MetaStruct<CleanT>::baseClasses, detail::BaseClassMemberTypeVisitor<V>{visitor});
 }
 
 template <typename T, typename V>
 constexpr auto visitAccummulate(T&& instance, V&& visitor) {
     using CleanT = detail::remove_cvref_t<T>;
-    const auto thisLevelResults =
-        detail::forEachAccum(MetaStruct<CleanT>::publicFields, detail::MemberVisitor<T, V>{instance, visitor});
-    return return std::tuple_cat(
-        std::move(thisLevelResults),
-        detail::forEachAccum<true>(MetaStruct<CleanT>::baseClasses,
-                                   detail::BaseClassMemberChainVisitor<T, V>{instance, visitor}));
+    auto thisLevelResults =
+        detail::forEachAccum(detail::ownFields<CleanT>, detail::MemberVisitor<T, V>{instance, visitor});
+    // Each base class contributes its own (already flat) results, all joined in one step.
+    return detail::tupleFlatten(std::move(thisLevelResults),
+                                detail::forEachAccum(MetaStruct<CleanT>::baseClasses,
+                                                     detail::BaseClassMemberChainVisitor<T, V>{instance, visitor}));
 }
 
 template <typename T, typename V>
 constexpr auto visitAccummulate(V&& visitor) {
     using CleanT = detail::remove_cvref_t<T>;
-    const auto thisLevelResults =
-        detail::forEachAccum(MetaStruct<CleanT>::publicFields, detail::MemberTypeVisitor<V>{visitor});
-    return std::tuple_cat(std::move(thisLevelResults),
-                          detail::forEachAccum<true>(MetaStruct<CleanT>::baseClasses,
-                                                     detail::BaseClassMemberTypeChainVisitor<V>{visitor}));
+    auto thisLevelResults = detail::forEachAccum(detail::ownFields<CleanT>, detail::MemberTypeVisitor<V>{visitor});
+    return detail::tupleFlatten(
+        std::move(thisLevelResults),
+        detail::forEachAccum(MetaStruct<CleanT>::baseClasses, detail::BaseClassMemberTypeChainVisitor<V>{visitor}));
 }
 
 // Aliases for the visit functions.
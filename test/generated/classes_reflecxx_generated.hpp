@@ -3,6 +3,8 @@
 // Autogenerated by visitor_generator.py.
 // Do not edit, changes will be overwritten!
 
+#include <array>
+#include <cstddef>
 #include <type_traits>
 
 #include <reflecxx/types.hpp>
@@ -24,6 +26,15 @@ struct MetaStructInternal<test_types::BasicClass> {
     );
     static constexpr auto baseClasses = std::make_tuple(
     );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 3> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, b), offsetof(U, i), offsetof(U, d)};
+        } else {
+            return {0, 4, 8};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
 };
 
 ////////////////////////////////////////////////////////////
@@ -40,6 +51,15 @@ struct MetaStructInternal<test_types::ChildClass> {
     static constexpr auto baseClasses = std::make_tuple(
         type_tag<test_types::BasicClass>{}
     );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 1> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, publicField)};
+        } else {
+            return {16};
+        }
+    }
+    static constexpr size_t unreflectedBytes{8};
 };
 
 ////////////////////////////////////////////////////////////
@@ -55,6 +75,15 @@ struct MetaStructInternal<test_types::OtherBaseClass> {
     );
     static constexpr auto baseClasses = std::make_tuple(
     );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 1> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, charField)};
+        } else {
+            return {0};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
 };
 
 ////////////////////////////////////////////////////////////
@@ -72,6 +101,15 @@ struct MetaStructInternal<test_types::SecondLevelChildClass> {
         type_tag<test_types::ChildClass>{},
         type_tag<test_types::OtherBaseClass>{}
     );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 1> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, someField)};
+        } else {
+            return {32};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
 };
 
 ////////////////////////////////////////////////////////////
@@ -88,6 +126,163 @@ struct MetaStructInternal<test_types::ChildOfUnreflectedBaseClass> {
     static constexpr auto baseClasses = std::make_tuple(
         // skipping unannotated base class test_types::UnreflectedBaseClass
     );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 1> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, childField)};
+        } else {
+            return {4};
+        }
+    }
+    static constexpr size_t unreflectedBytes{4};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::FieldlessChildClass
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::FieldlessChildClass> {
+    using Type = test_types::FieldlessChildClass;
+    static constexpr std::string_view name{"FieldlessChildClass"};
+    static constexpr auto publicFields = std::make_tuple(
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+        type_tag<test_types::BasicClass>{}
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 0> fieldOffsets() {
+        return {};
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::PolymorphicClass
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::PolymorphicClass> {
+    using Type = test_types::PolymorphicClass;
+    static constexpr std::string_view name{"PolymorphicClass"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::id, "id"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 1> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, id)};
+        } else {
+            return {8};
+        }
+    }
+    static constexpr size_t unreflectedBytes{sizeof(void*)};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::VirtualChildClass
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::VirtualChildClass> {
+    using Type = test_types::VirtualChildClass;
+    static constexpr std::string_view name{"VirtualChildClass"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::childField, "childField"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+        type_tag<test_types::BasicClass>{}
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 1> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, childField)};
+        } else {
+            return {8};
+        }
+    }
+    static constexpr size_t unreflectedBytes{sizeof(void*)};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::ConstructedClass
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::ConstructedClass> {
+    using Type = test_types::ConstructedClass;
+    static constexpr std::string_view name{"ConstructedClass"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::id, "id"},
+        ClassMember<Type, double>{&Type::value, "value"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 2> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, id), offsetof(U, value)};
+        } else {
+            return {0, 8};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::ShadowingClass
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::ShadowingClass> {
+    using Type = test_types::ShadowingClass;
+    static constexpr std::string_view name{"ShadowingClass"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::i, "i"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+        type_tag<test_types::BasicClass>{}
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 1> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, i)};
+        } else {
+            return {16};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::EncapsulatedClass
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::EncapsulatedClass> {
+    using Type = test_types::EncapsulatedClass;
+    static constexpr std::string_view name{"EncapsulatedClass"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, bool>{&Type::enabled, "enabled"}
+    );
+    static constexpr auto privateFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::id, "id"},
+        ClassMember<Type, double>{&Type::scale, "scale"},
+        ClassMember<Type, int>{&Type::count, "count"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 4> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, enabled), offsetof(U, id), offsetof(U, scale), offsetof(U, count)};
+        } else {
+            return {0, 4, 8, 16};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
 };
 
 } // namespace reflecxx::detail
@@ -3,6 +3,8 @@
 // Autogenerated by visitor_generator.py.
 // Do not edit, changes will be overwritten!
 
+#include <array>
+#include <cstddef>
 #include <type_traits>
 
 #include <reflecxx/types.hpp>
@@ -40,4 +42,38 @@ struct MetaEnumInternal<test_types::Scoped> {
     }};
 };
 
+////////////////////////////////////////////////////////////
+// test_types::Sparse
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaEnumInternal<test_types::Sparse> {
+    using Utype = std::underlying_type_t<test_types::Sparse>;
+    static constexpr std::string_view name{"Sparse"};
+    static constexpr std::array<Enumerator<test_types::Sparse>, 5> enumerators = {{
+        {test_types::Sparse::Negative, "Negative", Utype{-40}},
+        {test_types::Sparse::Zero, "Zero", Utype{0}},
+        {test_types::Sparse::Big, "Big", Utype{1000}},
+        {test_types::Sparse::Alias, "Alias", Utype{1000}},
+        {test_types::Sparse::Bigger, "Bigger", Utype{3000}},
+    }};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::Permission
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaEnumInternal<test_types::Permission> {
+    using Utype = std::underlying_type_t<test_types::Permission>;
+    static constexpr std::string_view name{"Permission"};
+    static constexpr std::array<Enumerator<test_types::Permission>, 5> enumerators = {{
+        {test_types::Permission::None, "None", Utype{0}},
+        {test_types::Permission::Read, "Read", Utype{1}},
+        {test_types::Permission::Write, "Write", Utype{2}},
+        {test_types::Permission::Execute, "Execute", Utype{4}},
+        {test_types::Permission::ReadWrite, "ReadWrite", Utype{3}},
+    }};
+};
+
 } // namespace reflecxx::detail
@@ -3,6 +3,8 @@
 // Autogenerated byvisitor_generator.py.
 // Do not edit, changes will be overwritten!
 
+#include <array>
+#include <cstddef>
 #include <type_traits>
 
 #include <reflecxx/types.hpp>
@@ -24,6 +26,15 @@ struct MetaStructInternal<test_types::BasicStruct> {
     );
     static constexpr auto baseClasses = std::make_tuple(
     );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 3> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, b), offsetof(U, i), offsetof(U, d)};
+        } else {
+            return {0, 4, 8};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
 };
 
 ////////////////////////////////////////////////////////////
@@ -43,6 +54,199 @@ struct MetaStructInternal<test_types::NestingStruct> {
     );
     static constexpr auto baseClasses = std::make_tuple(
     );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 5> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, i), offsetof(U, d), offsetof(U, bs), offsetof(U, basicsArr), offsetof(U, basicsStdarr)};
+        } else {
+            return {0, 8, 16, 32, 80};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::PackedStruct
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::PackedStruct> {
+    using Type = test_types::PackedStruct;
+    static constexpr std::string_view name{"PackedStruct"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::i, "i"},
+        ClassMember<Type, test_types::Scoped>{&Type::e, "e"},
+        ClassMember<Type, float [2]>{&Type::fArr, "fArr"},
+        ClassMember<Type, std::array<short, 2>>{&Type::sStdarr, "sStdarr"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 4> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, i), offsetof(U, e), offsetof(U, fArr), offsetof(U, sStdarr)};
+        } else {
+            return {0, 4, 8, 16};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::KeyStruct
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::KeyStruct> {
+    using Type = test_types::KeyStruct;
+    static constexpr std::string_view name{"KeyStruct"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::id, "id"},
+        ClassMember<Type, test_types::Scoped>{&Type::kind, "kind"},
+        ClassMember<Type, unsigned short [2]>{&Type::parts, "parts"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 3> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, id), offsetof(U, kind), offsetof(U, parts)};
+        } else {
+            return {0, 4, 8};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::PmrStruct
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::PmrStruct> {
+    using Type = test_types::PmrStruct;
+    static constexpr std::string_view name{"PmrStruct"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::id, "id"},
+        ClassMember<Type, std::basic_string<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>>>{&Type::name, "name"},
+        ClassMember<Type, std::vector<std::basic_string<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>>, std::pmr::polymorphic_allocator<std::basic_string<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>>>>>{&Type::tags, "tags"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 3> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, id), offsetof(U, name), offsetof(U, tags)};
+        } else {
+            return {0, 8, 48};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::PmrNestingStruct
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::PmrNestingStruct> {
+    using Type = test_types::PmrNestingStruct;
+    static constexpr std::string_view name{"PmrNestingStruct"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, test_types::PmrStruct>{&Type::single, "single"},
+        ClassMember<Type, std::vector<test_types::PmrStruct, std::pmr::polymorphic_allocator<test_types::PmrStruct>>>{&Type::many, "many"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 2> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, single), offsetof(U, many)};
+        } else {
+            return {0, 80};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::MixedPmrStruct
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::MixedPmrStruct> {
+    using Type = test_types::MixedPmrStruct;
+    static constexpr std::string_view name{"MixedPmrStruct"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::id, "id"},
+        ClassMember<Type, std::basic_string<char>>{&Type::label, "label"},
+        ClassMember<Type, std::basic_string<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>>>{&Type::name, "name"},
+        ClassMember<Type, std::vector<std::basic_string<char>, std::pmr::polymorphic_allocator<std::basic_string<char>>>>{&Type::tags, "tags"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 4> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, id), offsetof(U, label), offsetof(U, name), offsetof(U, tags)};
+        } else {
+            return {0, 8, 40, 80};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::FlagsStruct
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::FlagsStruct> {
+    using Type = test_types::FlagsStruct;
+    static constexpr std::string_view name{"FlagsStruct"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, int>{&Type::id, "id"},
+        ClassMember<Type, reflecxx::flags<test_types::Permission>>{&Type::permissions, "permissions"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 2> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, id), offsetof(U, permissions)};
+        } else {
+            return {0, 4};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
+};
+
+////////////////////////////////////////////////////////////
+// test_types::HotColdStruct
+////////////////////////////////////////////////////////////
+
+template <>
+struct MetaStructInternal<test_types::HotColdStruct> {
+    using Type = test_types::HotColdStruct;
+    static constexpr std::string_view name{"HotColdStruct"};
+    static constexpr auto publicFields = std::make_tuple(
+        ClassMember<Type, bool>{&Type::enabled, "enabled"},
+        ClassMember<Type, std::array<int, 32>>{&Type::history, "history"},
+        ClassMember<Type, double>{&Type::weight, "weight"},
+        ClassMember<Type, int>{&Type::count, "count"},
+        ClassMember<Type, bool>{&Type::ready, "ready"}
+    );
+    static constexpr auto baseClasses = std::make_tuple(
+    );
+    template <typename U = Type>
+    static constexpr std::array<size_t, 5> fieldOffsets() {
+        if constexpr (std::is_standard_layout_v<U>) {
+            return {offsetof(U, enabled), offsetof(U, history), offsetof(U, weight), offsetof(U, count), offsetof(U, ready)};
+        } else {
+            return {0, 4, 136, 144, 148};
+        }
+    }
+    static constexpr size_t unreflectedBytes{0};
 };
 
 } // namespace reflecxx::detail
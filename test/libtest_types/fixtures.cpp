@@ -0,0 +1,15 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <libtest_types/fixtures.hpp>
+
+namespace test_types {
+
+NestingStruct buildNestingStruct() {
+    BasicStruct b1{true, 1, 2.5};
+    BasicStruct b2{false, -5, 3.4};
+    return {9, -2.2, b1, {b1, b2, b1}, {b2, b2}};
+}
+
+} // namespace test_types
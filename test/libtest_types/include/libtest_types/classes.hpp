@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+
 #include <reflecxx/attributes.hpp>
+#include <reflecxx/struct_visitor.hpp>
 
 // test types in their own namespace to ensure names get qualified properly!
 namespace test_types {
@@ -48,6 +52,71 @@ class ChildOfUnreflectedBaseClass : public UnreflectedBaseClass {
     int childField{};
 } REFLECXX_T;
 
+// Declares no fields of its own, so unlike the other derived classes it's standard layout.
+class FieldlessChildClass : public BasicClass {
+ public:
+    int sum() const { return i + static_cast<int>(d); }
+} REFLECXX_T;
+
+// Holds a vtable pointer, which isn't reflected.
+class PolymorphicClass {
+ public:
+    virtual ~PolymorphicClass() = default;
+
+    int id{};
+} REFLECXX_T;
+
+// Its base's fields can only be reached through a cast, not through pointers to members of this class.
+class VirtualChildClass : public virtual BasicClass {
+ public:
+    int childField{};
+
+    bool operator==(const VirtualChildClass& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+// Can't be default constructed.
+class ConstructedClass {
+ public:
+    explicit ConstructedClass(int id)
+    : id(id) {}
+
+    int id;
+    double value{};
+} REFLECXX_T;
+
+// Both its own i and that of its base are visited.
+class ShadowingClass : public BasicClass {
+ public:
+    int i{};
+} REFLECXX_T;
+
+// Its non-public fields are reflected too.
+class EncapsulatedClass {
+    REFLECXX_FRIEND;
+
+ public:
+    EncapsulatedClass() = default;
+    EncapsulatedClass(int32_t id, double scale, int32_t count)
+    : id(id)
+    , scale(scale)
+    , count(count) {}
+
+    int32_t getId() const { return id; }
+    double getScale() const { return scale; }
+    int32_t getCount() const { return count; }
+
+    bool operator==(const EncapsulatedClass& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+
+    bool enabled{};
+
+ protected:
+    int32_t id{};
+
+ private:
+    double scale{};
+    int32_t count{};
+} REFLECXX_T;
+
 } // namespace test_types
 
 #include REFLECXX_HEADER(classes.hpp)
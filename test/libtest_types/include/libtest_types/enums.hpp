@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <reflecxx/attributes.hpp>
 
 // test types in their own namespace to ensure names get qualified properly!
@@ -11,6 +13,10 @@ namespace test_types {
 
 enum Unscoped { First = 2, Second, Third, Fourth } REFLECXX_T;
 enum class Scoped { First, Second, Third } REFLECXX_T;
+// Values too spread out for a direct lookup table, including a negative value and an alias.
+enum class Sparse : int16_t { Negative = -40, Zero = 0, Big = 1000, Alias = 1000, Bigger = 3000 } REFLECXX_T;
+// Bit flags, including an enumerator without any bits and one with several.
+enum class Permission : uint8_t { None = 0, Read = 1, Write = 2, Execute = 4, ReadWrite = 3 } REFLECXX_T;
 
 } // namespace test_types
 
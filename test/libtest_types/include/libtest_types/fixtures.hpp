@@ -0,0 +1,15 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#pragma once
+
+#include <libtest_types/structs.hpp>
+
+// Instances of the test types shared by several tests.
+namespace test_types {
+
+// A NestingStruct with non-default values in every field, nested ones included.
+NestingStruct buildNestingStruct();
+
+} // namespace test_types
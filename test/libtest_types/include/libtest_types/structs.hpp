@@ -5,9 +5,15 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <functional>
+#include <memory_resource>
+#include <string>
+#include <vector>
 
+#include <libtest_types/enums.hpp>
 #include <reflecxx/attributes.hpp>
+#include <reflecxx/flags.hpp>
 #include <reflecxx/struct_visitor.hpp>
 
 // test types in their own namespace to ensure names get qualified properly!
@@ -34,6 +40,69 @@ struct NestingStruct {
     bool operator==(const NestingStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
 } REFLECXX_T;
 
+// No padding anywhere, so the in-memory representation can be copied as is.
+struct PackedStruct {
+    int32_t i;
+    Scoped e;
+    float fArr[2];
+    std::array<int16_t, 2> sStdarr;
+
+    bool operator==(const PackedStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+// Every byte belongs to a field and no field is floating point, so equal values have identical bytes.
+struct KeyStruct {
+    int32_t id;
+    Scoped kind;
+    uint16_t parts[2];
+
+    bool operator==(const KeyStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+// Fields that allocate through a polymorphic allocator.
+struct PmrStruct {
+    int32_t id;
+    std::pmr::string name;
+    std::pmr::vector<std::pmr::string> tags;
+
+    bool operator==(const PmrStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+struct PmrNestingStruct {
+    PmrStruct single;
+    std::pmr::vector<PmrStruct> many;
+
+    bool operator==(const PmrNestingStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+// Only some of the fields allocate through a polymorphic allocator.
+struct MixedPmrStruct {
+    int32_t id;
+    std::string label;
+    std::pmr::string name;
+    std::pmr::vector<std::string> tags;
+
+    bool operator==(const MixedPmrStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+struct FlagsStruct {
+    int32_t id;
+    reflecxx::flags<Permission> permissions;
+
+    bool operator==(const FlagsStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
+// The frequently accessed fields are at the back, for the layout report to suggest moving them to the front.
+struct HotColdStruct {
+    bool enabled;
+    std::array<int32_t, 32> history;
+    double weight;
+    int32_t count REFLECXX_HOT;
+    bool ready REFLECXX_HOT;
+
+    bool operator==(const HotColdStruct& rhs) const { return REFLECXX_CMP(*this, rhs, std::equal_to<>{}); }
+} REFLECXX_T;
+
 } // namespace test_types
 
 #include REFLECXX_HEADER(structs.hpp)
@@ -0,0 +1,75 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/fixtures.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/binary_visitor.hpp>
+
+TEST(binary_visitor, binarySize) {
+    // no padding in the serialized form
+    static_assert(reflecxx::binarySize<test_types::BasicStruct>() == sizeof(bool) + sizeof(int) + sizeof(double));
+    static_assert(reflecxx::binarySize<test_types::NestingStruct>() ==
+                  sizeof(int) + sizeof(double) + 6 * reflecxx::binarySize<test_types::BasicStruct>());
+    static_assert(reflecxx::binarySize<test_types::PackedStruct>() == sizeof(test_types::PackedStruct));
+    // fields of base classes are included
+    static_assert(reflecxx::binarySize<test_types::SecondLevelChildClass>() ==
+                  2 * sizeof(double) + 2 * sizeof(int) + sizeof(bool) + sizeof(char));
+}
+
+TEST(binary_visitor, schemaOrder) {
+    test_types::BasicStruct bs{/*b=*/true, /*i=*/7, /*d=*/1.5};
+    const auto bytes = reflecxx::toBinary(bs);
+
+    bool b{};
+    int i{};
+    double d{};
+    std::memcpy(&b, bytes.data(), sizeof(b));
+    std::memcpy(&i, bytes.data() + sizeof(b), sizeof(i));
+    std::memcpy(&d, bytes.data() + sizeof(b) + sizeof(i), sizeof(d));
+
+    EXPECT_EQ(b, bs.b);
+    EXPECT_EQ(i, bs.i);
+    EXPECT_EQ(d, bs.d);
+}
+
+TEST(binary_visitor, packed) {
+    test_types::PackedStruct ps{-3, test_types::Scoped::Third, {1.5f, -2.5f}, {4, 5}};
+    const auto bytes = reflecxx::toBinary(ps);
+
+    // the serialized form is exactly the in-memory representation
+    EXPECT_EQ(std::memcmp(bytes.data(), &ps, sizeof(ps)), 0);
+
+    test_types::PackedStruct out{};
+    EXPECT_EQ(reflecxx::fromBinary(bytes.data(), out), bytes.data() + bytes.size());
+    EXPECT_EQ(out, ps);
+}
+
+TEST(binary_visitor, roundTrip) {
+    const auto ns = test_types::buildNestingStruct();
+    const auto bytes = reflecxx::toBinary(ns);
+
+    test_types::NestingStruct out{};
+    EXPECT_EQ(reflecxx::fromBinary(bytes.data(), out), bytes.data() + bytes.size());
+    EXPECT_EQ(out, ns);
+
+    test_types::SecondLevelChildClass sc{};
+    sc.someField = 1.5;
+    sc.publicField = 2;
+    sc.b = true;
+    sc.i = 3;
+    sc.d = 4.5;
+    sc.charField = 'c';
+
+    std::array<std::byte, reflecxx::binarySize<test_types::SecondLevelChildClass>()> buffer{};
+    EXPECT_EQ(reflecxx::toBinary(sc, buffer.data()), buffer.data() + buffer.size());
+
+    test_types::SecondLevelChildClass scOut{};
+    reflecxx::fromBinary(buffer.data(), scOut);
+    EXPECT_TRUE(reflecxx::equalTo(scOut, sc));
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <libtest_types/structs.hpp>
+#include <reflecxx/columnar.hpp>
+
+namespace {
+// Enough rows to cover whole blocks of lanes as well as a remainder.
+std::vector<test_types::BasicStruct> buildRows() {
+    std::vector<test_types::BasicStruct> rows;
+    for (int i = 0; i < 21; ++i) {
+        rows.push_back({i % 3 == 0, i - 10, 0.5 * i});
+    }
+    return rows;
+}
+
+reflecxx::soa_vector<test_types::BasicStruct> toSoa(const std::vector<test_types::BasicStruct>& rows) {
+    reflecxx::soa_vector<test_types::BasicStruct> soa;
+    for (const auto& row : rows) {
+        soa.push_back(row);
+    }
+    return soa;
+}
+} // namespace
+
+TEST(columnar, reduce) {
+    const auto rows = buildRows();
+    const auto soa = toSoa(rows);
+    const reflecxx::span<const test_types::BasicStruct> aos{rows};
+
+    // -10 + ... + 10
+    EXPECT_EQ(reflecxx::sum<1>(soa), 0);
+    EXPECT_EQ(reflecxx::sum<1>(aos), 0);
+    static_assert(std::is_same_v<decltype(reflecxx::sum<1>(soa)), int64_t>);
+    EXPECT_EQ(reflecxx::sum<2>(soa), 105.0);
+    EXPECT_EQ(reflecxx::sum<2>(aos), 105.0);
+
+    EXPECT_EQ(reflecxx::min<1>(soa), -10);
+    EXPECT_EQ(reflecxx::min<1>(aos), -10);
+    EXPECT_EQ(reflecxx::max<2>(soa), 10.0);
+    EXPECT_EQ(reflecxx::max<2>(aos), 10.0);
+
+    // plain columns
+    const std::array<uint8_t, 3> bytes{200, 100, 50};
+    EXPECT_EQ(reflecxx::sum(reflecxx::span<const uint8_t>{bytes}), 350u);
+    EXPECT_EQ(reflecxx::max(reflecxx::span<const uint8_t>{bytes}), 200);
+    EXPECT_EQ(reflecxx::min(reflecxx::span<const float>{}), std::nullopt);
+    EXPECT_EQ(reflecxx::sum(reflecxx::span<const float>{}), 0.0f);
+}
+
+TEST(columnar, filter) {
+    const auto rows = buildRows();
+    const auto soa = toSoa(rows);
+    const reflecxx::span<const test_types::BasicStruct> aos{rows};
+
+    const std::vector<size_t> expected{18, 19, 20};
+    EXPECT_EQ(reflecxx::filter<2>(soa, [](double d) { return d >= 9.0; }), expected);
+    EXPECT_EQ(reflecxx::filter<2>(aos, [](double d) { return d >= 9.0; }), expected);
+    EXPECT_EQ(reflecxx::filter<0>(soa, [](bool b) { return b; }).size(), 7u);
+    EXPECT_TRUE(reflecxx::filter<1>(soa, [](int i) { return i > 100; }).empty());
+}
+
+TEST(columnar, byName) {
+    const auto rows = buildRows();
+    const auto soa = toSoa(rows);
+    const reflecxx::span<const test_types::BasicStruct> aos{rows};
+
+    // the index of a field can be looked up by name at compile time
+    constexpr auto d = reflecxx::fieldIndex<test_types::BasicStruct>("d");
+    EXPECT_EQ(reflecxx::sum<d>(soa), 105.0);
+    EXPECT_EQ(reflecxx::max<d>(aos), 10.0);
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+    EXPECT_EQ(reflecxx::sum<"d">(soa), 105.0);
+    EXPECT_EQ(reflecxx::sum<"i">(aos), 0);
+    EXPECT_EQ(reflecxx::min<"i">(soa), -10);
+    EXPECT_EQ(reflecxx::max<"d">(aos), 10.0);
+    EXPECT_EQ(reflecxx::filter<"d">(soa, [](double v) { return v >= 9.0; }), (std::vector<size_t>{18, 19, 20}));
+    EXPECT_EQ(reflecxx::filter<"b">(aos, [](bool b) { return b; }).size(), 7u);
+#endif
+}
+
+TEST(columnar, equalTo) {
+    auto rows = buildRows();
+    const auto soa = toSoa(rows);
+    rows[3].d = -1;
+    rows[20].b = !rows[20].b;
+    const auto other = toSoa(rows);
+
+    // std::vector<bool> isn't contiguous, so use a bool array.
+    std::unique_ptr<bool[]> eq{new bool[rows.size()]};
+    const reflecxx::span<bool> outSpan{eq.get(), rows.size()};
+
+    reflecxx::equalTo(soa, other, outSpan);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        EXPECT_EQ(outSpan[i], i != 3 && i != 20) << i;
+    }
+
+    const auto original = buildRows();
+    reflecxx::equalTo(reflecxx::span<const test_types::BasicStruct>{original},
+                      reflecxx::span<const test_types::BasicStruct>{rows}, outSpan);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        EXPECT_EQ(outSpan[i], i != 3 && i != 20) << i;
+    }
+
+    // array fields are compared element-wise
+    reflecxx::soa_vector<test_types::PackedStruct> ps1{{1, test_types::Scoped::First, {1, 2}, {3, 4}}};
+    auto ps2 = ps1;
+    ps2[0].get<2>()[1] = 5;
+    reflecxx::equalTo(ps1, ps1, outSpan.subspan(0, 1));
+    EXPECT_TRUE(outSpan[0]);
+    reflecxx::equalTo(ps1, ps2, outSpan.subspan(0, 1));
+    EXPECT_FALSE(outSpan[0]);
+
+    EXPECT_THROW(reflecxx::equalTo(soa, other, outSpan.subspan(1)), std::invalid_argument);
+}
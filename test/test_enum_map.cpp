@@ -0,0 +1,109 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libtest_types/enums.hpp>
+#include <reflecxx/enum_map.hpp>
+
+using test_types::Scoped;
+using test_types::Sparse;
+
+TEST(enum_map, enumIndex) {
+    // values starting above zero
+    static_assert(reflecxx::enumIndex(test_types::First) == 0);
+    static_assert(reflecxx::enumIndex(test_types::Fourth) == 3);
+    // sparse values, with an alias sharing the index of the first enumerator with its value
+    static_assert(reflecxx::enumIndex(Sparse::Negative) == 0);
+    static_assert(reflecxx::enumIndex(Sparse::Alias) == 2);
+    static_assert(reflecxx::enumIndex(Sparse::Bigger) == 4);
+
+    static_assert(reflecxx::tryEnumIndex(Scoped::Third) == 2u);
+    static_assert(reflecxx::tryEnumIndex(static_cast<Sparse>(1)) == std::nullopt);
+    static_assert(noexcept(reflecxx::tryEnumIndex(Scoped::Third)));
+    EXPECT_THROW(reflecxx::enumIndex(static_cast<Scoped>(3)), std::runtime_error);
+
+    for (const auto& e : reflecxx::MetaEnum<Sparse>::enumerators) {
+        EXPECT_EQ(reflecxx::MetaEnum<Sparse>::enumerators[reflecxx::enumIndex(e.enumerator)].value, e.value);
+    }
+    for (const int16_t missing : {-41, -39, 1, 999, 1001, 2000, 3001, INT16_MIN, INT16_MAX}) {
+        EXPECT_EQ(reflecxx::tryEnumIndex(static_cast<Sparse>(missing)), std::nullopt);
+    }
+}
+
+TEST(enum_map, map) {
+    reflecxx::enum_map<Sparse, int> counts;
+    static_assert(decltype(counts)::size() == 4);
+    EXPECT_EQ(counts[Sparse::Zero], 0);
+
+    ++counts[Sparse::Zero];
+    counts[Sparse::Big] += 2;
+    // an alias is the same key
+    counts[Sparse::Alias] += 3;
+    EXPECT_EQ(counts[Sparse::Big], 5);
+    EXPECT_EQ(counts.at(Sparse::Zero), 1);
+    EXPECT_THROW(counts.at(static_cast<Sparse>(1)), std::runtime_error);
+
+    std::vector<std::pair<Sparse, int>> visited;
+    for (const auto [key, value] : counts) {
+        visited.emplace_back(key, value);
+    }
+    EXPECT_EQ(visited, (std::vector<std::pair<Sparse, int>>{
+                           {Sparse::Negative, 0}, {Sparse::Zero, 1}, {Sparse::Big, 5}, {Sparse::Bigger, 0}}));
+
+    for (auto [key, value] : counts) {
+        value = static_cast<int>(key);
+    }
+    EXPECT_EQ(counts[Sparse::Negative], -40);
+    EXPECT_EQ(counts[Sparse::Bigger], 3000);
+
+    counts.fill(7);
+    EXPECT_EQ(counts, (reflecxx::enum_map<Sparse, int>{
+                          {Sparse::Negative, 7}, {Sparse::Zero, 7}, {Sparse::Big, 7}, {Sparse::Bigger, 7}}));
+}
+
+TEST(enum_map, constexprMap) {
+    constexpr reflecxx::enum_map<Scoped, std::string_view> labels{{Scoped::First, "one"}, {Scoped::Third, "three"}};
+    static_assert(labels[Scoped::First] == "one");
+    static_assert(labels[Scoped::Second].empty());
+    static_assert(labels.at(Scoped::Third) == "three");
+    static_assert(sizeof(labels) == 3 * sizeof(std::string_view));
+}
+
+TEST(enum_map, set) {
+    constexpr reflecxx::enum_set<Sparse> constSet{Sparse::Zero, Sparse::Bigger};
+    static_assert(constSet.contains(Sparse::Bigger) && !constSet.contains(Sparse::Big));
+    static_assert(constSet.size() == 2);
+    static_assert(reflecxx::enum_set<Sparse>::max_size() == 4);
+
+    reflecxx::enum_set<Sparse> set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert(Sparse::Bigger));
+    EXPECT_TRUE(set.insert(Sparse::Negative));
+    EXPECT_FALSE(set.insert(Sparse::Bigger));
+    EXPECT_TRUE(set.insert(Sparse::Alias));
+    EXPECT_TRUE(set.contains(Sparse::Big));
+    EXPECT_EQ(set.count(Sparse::Zero), 0u);
+    EXPECT_FALSE(set.contains(static_cast<Sparse>(1)));
+    EXPECT_THROW(set.insert(static_cast<Sparse>(1)), std::runtime_error);
+
+    EXPECT_EQ(std::vector<Sparse>(set.begin(), set.end()),
+              (std::vector<Sparse>{Sparse::Negative, Sparse::Big, Sparse::Bigger}));
+
+    EXPECT_TRUE(set.erase(Sparse::Big));
+    EXPECT_FALSE(set.erase(Sparse::Big));
+    EXPECT_FALSE(set.erase(static_cast<Sparse>(1)));
+    EXPECT_EQ(set, (reflecxx::enum_set<Sparse>{Sparse::Negative, Sparse::Bigger}));
+
+    set.clear();
+    EXPECT_EQ(set.size(), 0u);
+    EXPECT_EQ(set.begin(), set.end());
+}
@@ -23,6 +23,27 @@ TEST(enum_visitor, enumSize) {
 TEST(enum_visitor, toName) {
     static_assert(reflecxx::enumName(test_types::Fourth) == "Fourth");
     static_assert(reflecxx::enumName(test_types::Scoped::Third) == "Third");
+
+    // sparse values, looked up by perfect hash
+    static_assert(reflecxx::enumName(test_types::Sparse::Negative) == "Negative");
+    static_assert(reflecxx::enumName(test_types::Sparse::Bigger) == "Bigger");
+    // aliases resolve to the first enumerator declared with the value
+    static_assert(reflecxx::enumName(test_types::Sparse::Alias) == "Big");
+
+    EXPECT_ANY_THROW(reflecxx::enumName(static_cast<test_types::Scoped>(3)));
+}
+
+TEST(enum_visitor, tryEnumName) {
+    static_assert(reflecxx::tryEnumName(test_types::Second) == "Second");
+    static_assert(reflecxx::tryEnumName(test_types::Sparse::Zero) == "Zero");
+    static_assert(noexcept(reflecxx::tryEnumName(test_types::Second)));
+
+    // out of range on either side, and gaps within the range
+    EXPECT_TRUE(reflecxx::tryEnumName(static_cast<test_types::Unscoped>(1)).empty());
+    EXPECT_TRUE(reflecxx::tryEnumName(static_cast<test_types::Unscoped>(6)).empty());
+    EXPECT_TRUE(reflecxx::tryEnumName(static_cast<test_types::Sparse>(-41)).empty());
+    EXPECT_TRUE(reflecxx::tryEnumName(static_cast<test_types::Sparse>(1)).empty());
+    EXPECT_TRUE(reflecxx::tryEnumName(static_cast<test_types::Sparse>(3001)).empty());
 }
 
 TEST(enum_visitor, fromName) {
@@ -39,6 +60,22 @@ TEST(enum_visitor, fromName) {
     EXPECT_ANY_THROW(reflecxx::fromName<test_types::Scoped>("fifth"));
 }
 
+TEST(enum_visitor, tryFromName) {
+    static_assert(reflecxx::tryFromName<test_types::Unscoped>("First") == test_types::First);
+    static_assert(reflecxx::tryFromName<test_types::Scoped>("Second") == test_types::Scoped::Second);
+    static_assert(!reflecxx::tryFromName<test_types::Scoped>("fifth"));
+
+    // every name should hash to its own enumerator
+    for (const auto& e : reflecxx::enumerators<test_types::Unscoped>()) {
+        EXPECT_EQ(reflecxx::tryFromName<test_types::Unscoped>(reflecxx::enumName(e)), e);
+    }
+
+    // near misses and prefixes are rejected by the final comparison
+    EXPECT_EQ(reflecxx::tryFromName<test_types::Unscoped>("Firs"), std::nullopt);
+    EXPECT_EQ(reflecxx::tryFromName<test_types::Unscoped>("Firstt"), std::nullopt);
+    EXPECT_EQ(reflecxx::tryFromName<test_types::Unscoped>(""), std::nullopt);
+}
+
 TEST(enum_visitor, contains) {
     // unscoped has an offset of 2 in values
     static_assert(!reflecxx::enumContains<test_types::Unscoped>(0));
@@ -46,6 +83,11 @@ TEST(enum_visitor, contains) {
 
     static_assert(reflecxx::enumContains<test_types::Scoped>(0));
     static_assert(!reflecxx::enumContains<test_types::Scoped>(3));
+
+    static_assert(reflecxx::enumContains<test_types::Sparse>(-40));
+    static_assert(reflecxx::enumContains<test_types::Sparse>(1000));
+    static_assert(!reflecxx::enumContains<test_types::Sparse>(-1));
+    static_assert(!reflecxx::enumContains<test_types::Sparse>(2999));
 }
 
 TEST(enum_visitor, enumerators) {
@@ -0,0 +1,110 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include <libtest_types/enums.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/binary_visitor.hpp>
+#include <reflecxx/flags.hpp>
+#include <reflecxx/json_reader.hpp>
+#include <reflecxx/json_writer.hpp>
+
+using test_types::Permission;
+using Permissions = reflecxx::flags<Permission>;
+
+TEST(flags, bitOperations) {
+    constexpr Permissions rx{Permission::Read, Permission::Execute};
+    static_assert(rx.bits() == 5);
+    static_assert(rx.test(Permission::Read) && !rx.test(Permission::Write));
+    // every bit of a multi-bit enumerator must be set
+    static_assert(!rx.test(Permission::ReadWrite));
+    static_assert(rx.count() == 2);
+    static_assert(sizeof(Permissions) == sizeof(Permission));
+
+    static_assert((rx | Permission::Write) == Permissions::all());
+    static_assert((rx & Permission::Read) == Permission::Read);
+    static_assert((rx ^ Permission::ReadWrite) == Permissions{Permission::Write, Permission::Execute});
+    // the complement only has bits of enumerators
+    static_assert(~rx == Permission::Write);
+    static_assert(Permissions{}.none() && !Permissions{});
+
+    Permissions p;
+    p.set(Permission::ReadWrite).reset(Permission::Read);
+    EXPECT_EQ(p, Permission::Write);
+    p.flip(Permission::Execute);
+    EXPECT_TRUE(p & Permission::Execute);
+    p.clear();
+    EXPECT_TRUE(p.none());
+
+    std::unordered_set<Permissions> set{rx, Permission::Write};
+    EXPECT_EQ(set.count(Permissions{Permission::Execute, Permission::Read}), 1u);
+}
+
+TEST(flags, iteration) {
+    std::vector<Permission> visited;
+    for (const auto p : Permissions{Permission::Execute, Permission::Read}) {
+        visited.push_back(p);
+    }
+    EXPECT_EQ(visited, (std::vector<Permission>{Permission::Read, Permission::Execute}));
+
+    // bits without an enumerator are visited as well
+    visited.clear();
+    for (const auto p : Permissions::fromBits(0x41)) {
+        visited.push_back(p);
+    }
+    EXPECT_EQ(visited, (std::vector<Permission>{Permission::Read, static_cast<Permission>(0x40)}));
+    EXPECT_EQ(Permissions{}.begin(), Permissions{}.end());
+}
+
+TEST(flags, format) {
+    EXPECT_EQ(reflecxx::flagsToString(Permissions{Permission::Execute, Permission::Read}), "Read|Execute");
+    // single bit names are used, so the result doesn't depend on how the set was built
+    EXPECT_EQ(reflecxx::flagsToString(Permissions{Permission::ReadWrite}), "Read|Write");
+    EXPECT_EQ(reflecxx::flagsToString(Permissions{}), "");
+    EXPECT_EQ(reflecxx::flagsToString(Permissions::fromBits(0xc2)), "Write|192");
+}
+
+TEST(flags, parse) {
+    static_assert(reflecxx::flagsFromString<Permission>("Read|Execute") ==
+                  Permissions{Permission::Read, Permission::Execute});
+    static_assert(reflecxx::flagsFromString<Permission>("ReadWrite") ==
+                  Permissions{Permission::Read, Permission::Write});
+    EXPECT_EQ(reflecxx::flagsFromString<Permission>(" Write | Execute "),
+              (Permissions{Permission::Write, Permission::Execute}));
+    EXPECT_EQ(reflecxx::flagsFromString<Permission>(""), Permissions{});
+    EXPECT_EQ(reflecxx::flagsFromString<Permission>("None"), Permissions{});
+    EXPECT_EQ(reflecxx::flagsFromString<Permission>("Write|192"), Permissions::fromBits(0xc2));
+
+    EXPECT_EQ(reflecxx::tryFlagsFromString<Permission>("Read|Delete"), std::nullopt);
+    EXPECT_EQ(reflecxx::tryFlagsFromString<Permission>("Read|"), std::nullopt);
+    EXPECT_EQ(reflecxx::tryFlagsFromString<Permission>("256"), std::nullopt);
+    EXPECT_THROW(reflecxx::flagsFromString<Permission>("read"), std::runtime_error);
+}
+
+TEST(flags, json) {
+    const test_types::FlagsStruct s{7, {Permission::Read, Permission::Execute}};
+    const auto json = reflecxx::toJsonString(s);
+    EXPECT_EQ(json, R"({"id":7,"permissions":"Read|Execute"})");
+    EXPECT_EQ(reflecxx::fromJsonString<test_types::FlagsStruct>(json), s);
+
+    // also read from the bits
+    EXPECT_EQ(reflecxx::fromJsonString<Permissions>("5"), s.permissions);
+    EXPECT_THROW(reflecxx::fromJsonString<Permissions>(R"("Read|Delete")"), std::runtime_error);
+}
+
+TEST(flags, binary) {
+    static_assert(reflecxx::binarySize<test_types::FlagsStruct>() == sizeof(int32_t) + sizeof(Permission));
+
+    const test_types::FlagsStruct s{-3, {Permission::Write, Permission::Execute}};
+    const auto bytes = reflecxx::toBinary(s);
+    test_types::FlagsStruct roundTrip{};
+    reflecxx::fromBinary(bytes.data(), roundTrip);
+    EXPECT_EQ(roundTrip, s);
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/fixtures.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/hash.hpp>
+
+REFLECXX_STD_HASH(test_types::KeyStruct)
+
+TEST(hash, bytewise) {
+    static_assert(reflecxx::detail::is_bytewise_hashable_v<test_types::KeyStruct>);
+    static_assert(reflecxx::detail::is_bytewise_hashable_v<test_types::KeyStruct[2]>);
+    // padding
+    static_assert(!reflecxx::detail::is_bytewise_hashable_v<test_types::BasicStruct>);
+    // floating point
+    static_assert(!reflecxx::detail::is_bytewise_hashable_v<test_types::PackedStruct>);
+    // bytes of a base class that isn't visitable
+    static_assert(!reflecxx::detail::is_bytewise_hashable_v<test_types::ChildOfUnreflectedBaseClass>);
+}
+
+TEST(hash, equalValuesHashEqual) {
+    const test_types::KeyStruct k1{7, test_types::Scoped::Second, {1, 2}};
+    const test_types::KeyStruct k2 = k1;
+    EXPECT_EQ(reflecxx::hashValue(k1), reflecxx::hashValue(k2));
+
+    const auto n1 = test_types::buildNestingStruct();
+    auto n2 = test_types::buildNestingStruct();
+    EXPECT_EQ(reflecxx::hashValue(n1), reflecxx::hashValue(n2));
+
+    // 0.0 and -0.0 are equal, so must hash the same
+    test_types::BasicStruct b1{true, 1, 0.0};
+    test_types::BasicStruct b2{true, 1, -0.0};
+    ASSERT_TRUE(reflecxx::equalTo(b1, b2));
+    EXPECT_EQ(reflecxx::hashValue(b1), reflecxx::hashValue(b2));
+
+    // Fields that aren't visitable don't take part in comparison, so they don't take part in the hash either.
+    test_types::ChildOfUnreflectedBaseClass c1{};
+    test_types::ChildOfUnreflectedBaseClass c2{};
+    c1.childField = c2.childField = 3;
+    c2.baseField = 4;
+    EXPECT_EQ(reflecxx::hashValue(c1), reflecxx::hashValue(c2));
+}
+
+TEST(hash, everyFieldContributes) {
+    const test_types::KeyStruct key{7, test_types::Scoped::Second, {1, 2}};
+    auto other = key;
+    other.parts[1] = 3;
+    EXPECT_NE(reflecxx::hashValue(key), reflecxx::hashValue(other));
+    other = key;
+    other.kind = test_types::Scoped::Third;
+    EXPECT_NE(reflecxx::hashValue(key), reflecxx::hashValue(other));
+
+    const auto n1 = test_types::buildNestingStruct();
+    auto n2 = n1;
+    // nested in a C-style array
+    n2.basicsArr[2].d = 7.5;
+    EXPECT_NE(reflecxx::hashValue(n1), reflecxx::hashValue(n2));
+    n2 = n1;
+    // nested in a std::array
+    n2.basicsStdarr[1].b = true;
+    EXPECT_NE(reflecxx::hashValue(n1), reflecxx::hashValue(n2));
+
+    // base class fields
+    test_types::SecondLevelChildClass s1{};
+    auto s2 = s1;
+    s2.i = 1;
+    EXPECT_NE(reflecxx::hashValue(s1), reflecxx::hashValue(s2));
+
+    // private fields of classes that reflect them
+    const test_types::EncapsulatedClass e1{1, 2.5, 3};
+    EXPECT_EQ(reflecxx::hashValue(e1), reflecxx::hashValue(test_types::EncapsulatedClass{1, 2.5, 3}));
+    EXPECT_NE(reflecxx::hashValue(e1), reflecxx::hashValue(test_types::EncapsulatedClass{1, 2.5, 4}));
+}
+
+TEST(hash, orderMatters) {
+    test_types::BasicStruct b1{true, 1, 2.0};
+    test_types::BasicStruct b2{true, 2, 1.0};
+    EXPECT_NE(reflecxx::hashValue(b1), reflecxx::hashValue(b2));
+
+    test_types::NestingStruct n1{};
+    auto n2 = n1;
+    n1.basicsArr[0].i = 1;
+    n2.basicsArr[1].i = 1;
+    EXPECT_NE(reflecxx::hashValue(n1), reflecxx::hashValue(n2));
+}
+
+TEST(hash, unorderedContainers) {
+    std::unordered_map<test_types::NestingStruct, int, reflecxx::hash<test_types::NestingStruct>> counts;
+    counts[test_types::buildNestingStruct()]++;
+    counts[test_types::buildNestingStruct()]++;
+    counts[test_types::NestingStruct{}]++;
+    EXPECT_EQ(counts.size(), 2u);
+    EXPECT_EQ(counts[test_types::buildNestingStruct()], 2);
+
+    // opted in to std::hash
+    std::unordered_set<test_types::KeyStruct> keys;
+    keys.insert({1, test_types::Scoped::First, {0, 0}});
+    keys.insert({1, test_types::Scoped::First, {0, 0}});
+    keys.insert({2, test_types::Scoped::First, {0, 0}});
+    EXPECT_EQ(keys.size(), 2u);
+    EXPECT_EQ(std::hash<test_types::KeyStruct>{}({2, test_types::Scoped::First, {0, 0}}),
+              reflecxx::hashValue(test_types::KeyStruct{2, test_types::Scoped::First, {0, 0}}));
+}
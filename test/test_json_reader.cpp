@@ -0,0 +1,161 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/enums.hpp>
+#include <libtest_types/fixtures.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/json_reader.hpp>
+#include <reflecxx/json_writer.hpp>
+
+TEST(json_reader, values) {
+    EXPECT_EQ(reflecxx::fromJsonString<bool>(" true "), true);
+    EXPECT_EQ(reflecxx::fromJsonString<int>("-17"), -17);
+    EXPECT_EQ(reflecxx::fromJsonString<double>("1.5e2"), 150.0);
+    EXPECT_TRUE(std::isnan(reflecxx::fromJsonString<double>("null")));
+    EXPECT_EQ(reflecxx::fromJsonString<std::optional<int>>("null"), std::nullopt);
+    EXPECT_EQ(reflecxx::fromJsonString<std::optional<int>>("3"), 3);
+    EXPECT_EQ(reflecxx::fromJsonString<std::vector<int>>("[1, 2,3]"), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(reflecxx::fromJsonString<std::vector<int>>("[ ]"), std::vector<int>{});
+
+    // char arrays are read back from arrays, as written
+    const char chars[4] = {'a', 'b', 0, 'c'};
+    char charsRead[4]{};
+    reflecxx::readJson(reflecxx::toJsonString(chars), charsRead);
+    EXPECT_EQ(std::string(charsRead, 4), std::string(chars, 4));
+
+    // reflected enums are read by name or value
+    EXPECT_EQ(reflecxx::fromJsonString<test_types::Scoped>(R"("Second")"), test_types::Scoped::Second);
+    EXPECT_EQ(reflecxx::fromJsonString<test_types::Scoped>("7"), static_cast<test_types::Scoped>(7));
+}
+
+TEST(json_reader, strings) {
+    EXPECT_EQ(reflecxx::fromJsonString<std::string>(R"("plain")"), "plain");
+    EXPECT_EQ(reflecxx::fromJsonString<std::string>(R"("a\"b\\c\nd\u0001\/")"), "a\"b\\c\nd\x01/");
+    // multi-byte code points and surrogate pairs are encoded as UTF-8
+    EXPECT_EQ(reflecxx::fromJsonString<std::string>(R"("\u00e9\u20AC\ud83d\ude00")"),
+              "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+}
+
+TEST(json_reader, structs) {
+    const auto ns = test_types::buildNestingStruct();
+    EXPECT_EQ(reflecxx::fromJsonString<test_types::NestingStruct>(reflecxx::toJsonString(ns)), ns);
+
+    test_types::PackedStruct ps{-3, test_types::Scoped::Third, {1.5f, -2.5f}, {4, 5}};
+    EXPECT_EQ(reflecxx::fromJsonString<test_types::PackedStruct>(reflecxx::toJsonString(ps)), ps);
+
+    // keys out of declaration order, unknown keys of any type, and whitespace
+    const auto bs = reflecxx::fromJsonString<test_types::BasicStruct>(
+        R"( { "d" : 2.5, "unknown": {"x": [1, "]", {"y": null}]}, "i": 1, "other": "\"}", "b": true } )");
+    EXPECT_EQ(bs.b, true);
+    EXPECT_EQ(bs.i, 1);
+    EXPECT_EQ(bs.d, 2.5);
+
+    // fields of base classes are included
+    const auto sc = reflecxx::fromJsonString<test_types::SecondLevelChildClass>(
+        R"({"someField":1.5,"publicField":2,"b":true,"i":3,"d":4.5,"charField":65})");
+    EXPECT_EQ(sc.someField, 1.5);
+    EXPECT_EQ(sc.publicField, 2);
+    EXPECT_EQ(sc.b, true);
+    EXPECT_EQ(sc.i, 3);
+    EXPECT_EQ(sc.d, 4.5);
+    EXPECT_EQ(sc.charField, 'A');
+
+    // a field shadowing one of its base class is written first, so both are read back in order
+    test_types::ShadowingClass shc{};
+    shc.i = 1;
+    shc.BasicClass::i = 2;
+    shc.d = 2.5;
+    const auto shcRead = reflecxx::fromJsonString<test_types::ShadowingClass>(reflecxx::toJsonString(shc));
+    EXPECT_EQ(shcRead.i, 1);
+    EXPECT_EQ(shcRead.BasicClass::i, 2);
+    EXPECT_EQ(shcRead.d, 2.5);
+    // otherwise the name refers to the derived field
+    reflecxx::readJsonFields(R"({"d":1.5,"i":3})", shc);
+    EXPECT_EQ(shc.i, 3);
+    EXPECT_EQ(shc.BasicClass::i, 2);
+}
+
+TEST(json_reader, errors) {
+    // malformed
+    EXPECT_THROW(reflecxx::fromJsonString<int>("1.5"), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromJsonString<int>("1 2"), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromJsonString<int8_t>("300"), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromJsonString<bool>("tru"), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromJsonString<std::string>(R"("abc)"), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromJsonString<std::string>(R"("\q")"), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromJsonString<std::vector<int>>("[1,]"), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromJsonString<test_types::BasicStruct>(R"({"b":true,"i":1,"d":2.5,"x":})"),
+                 std::runtime_error);
+
+    // structurally mismatched
+    EXPECT_THROW(reflecxx::fromJsonString<test_types::Scoped>(R"("Fourth")"), std::runtime_error);
+    EXPECT_THROW((reflecxx::fromJsonString<std::array<int, 2>>("[1]")), std::runtime_error);
+    EXPECT_THROW((reflecxx::fromJsonString<std::array<int, 2>>("[1,2,3]")), std::runtime_error);
+    try {
+        reflecxx::fromJsonString<test_types::BasicStruct>(R"({"b":true,"d":2.5})");
+        FAIL() << "Expected missing field";
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(std::string{e.what()}, "JSON parse error at offset 18: missing field i");
+    }
+}
+
+TEST(json_reader, memoryResource) {
+    constexpr std::string_view json =
+        R"({"single":{"id":1,"name":"a name long enough to allocate","tags":["x","y"]},)"
+        R"("many":[{"id":2,"name":"another name long enough to allocate","tags":["a\nb"]},{"id":3,"name":"","tags":[]}]})";
+
+    std::pmr::monotonic_buffer_resource arena;
+    // Any allocation that doesn't come from the arena throws.
+    auto* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    test_types::PmrNestingStruct s;
+    try {
+        reflecxx::readJson(json, s, &arena);
+    } catch (...) {
+        std::pmr::set_default_resource(previous);
+        throw;
+    }
+    std::pmr::set_default_resource(previous);
+
+    EXPECT_EQ(s.single.name, "a name long enough to allocate");
+    EXPECT_EQ(s.single.tags.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.single.tags[1], "y");
+    ASSERT_EQ(s.many.size(), 2u);
+    EXPECT_EQ(s.many.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.many[0].name.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.many[0].tags[0], "a\nb");
+    EXPECT_EQ(s.many[1].id, 3);
+
+    // without a resource, pmr fields are read like any others
+    test_types::PmrNestingStruct defaulted;
+    reflecxx::readJson(json, defaulted);
+    EXPECT_EQ(defaulted, s);
+    EXPECT_EQ(defaulted.single.name.get_allocator().resource(), std::pmr::get_default_resource());
+}
+
+TEST(json_reader, memoryResourceMixed) {
+    constexpr std::string_view json =
+        R"({"id":4,"label":"a label long enough to allocate","name":"a name long enough to allocate",)"
+        R"("tags":["a tag long enough to allocate"]})";
+
+    // fields that don't use a polymorphic allocator are read as usual
+    std::pmr::monotonic_buffer_resource arena;
+    test_types::MixedPmrStruct s;
+    reflecxx::readJson(json, s, &arena);
+    EXPECT_EQ(s.label, "a label long enough to allocate");
+    EXPECT_EQ(s.name.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.tags.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.tags[0], "a tag long enough to allocate");
+}
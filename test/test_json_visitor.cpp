@@ -4,8 +4,11 @@
 
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 #include <libtest_types/structs.hpp>
 #include <reflecxx/json_visitor.hpp>
+#include <reflecxx/patch_json.hpp>
 
 namespace {
 test_types::NestingStruct buildNestingStruct() {
@@ -44,3 +47,70 @@ TEST(json_visitor, fromJson) {
 
     EXPECT_EQ(nsFromJson, buildNestingStruct());
 }
+
+TEST(json_visitor, patch) {
+    const auto from = buildNestingStruct();
+    auto to = from;
+    to.d = 1.5;
+    to.basicsArr[1].b = true;
+    const auto patch = reflecxx::diff(from, to);
+
+    nlohmann::json j = patch;
+    EXPECT_EQ(j.dump(), R"([{"path":[1],"value":1.5},{"path":[3,1,0],"value":true}])");
+
+    const auto patchFromJson = j.get<reflecxx::Patch<test_types::NestingStruct>>();
+    EXPECT_EQ(patchFromJson.entries, patch.entries);
+}
+
+TEST(json_visitor, flags) {
+    const test_types::FlagsStruct s{4, {test_types::Permission::Write, test_types::Permission::Execute}};
+    const nlohmann::json j = s;
+    EXPECT_EQ(j.dump(), R"({"id":4,"permissions":"Write|Execute"})");
+    EXPECT_EQ(j.get<test_types::FlagsStruct>(), s);
+}
+
+TEST(json_visitor, memoryResource) {
+    const nlohmann::json j = {
+        {"single", {{"id", 1}, {"name", "a name long enough to allocate"}, {"tags", {"x", "y"}}}},
+        {"many",
+         {{{"id", 2}, {"name", "another name long enough to allocate"}, {"tags", {"z"}}},
+          {{"id", 3}, {"name", ""}, {"tags", nlohmann::json::array()}}}}};
+
+    std::pmr::monotonic_buffer_resource arena;
+    // Any allocation that doesn't come from the arena throws.
+    auto* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    test_types::PmrNestingStruct s;
+    try {
+        reflecxx::fromJson(j, s, &arena);
+    } catch (...) {
+        std::pmr::set_default_resource(previous);
+        throw;
+    }
+    std::pmr::set_default_resource(previous);
+
+    EXPECT_EQ(s.single.name, "a name long enough to allocate");
+    EXPECT_EQ(s.single.tags.get_allocator().resource(), &arena);
+    ASSERT_EQ(s.many.size(), 2u);
+    EXPECT_EQ(s.many[0].name.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.many[0].tags[0], "z");
+
+    // without a resource, pmr fields are converted like any others
+    EXPECT_EQ(j.get<test_types::PmrNestingStruct>(), s);
+}
+
+TEST(json_visitor, memoryResourceMixed) {
+    const nlohmann::json j = {{"id", 4},
+                              {"label", "a label long enough to allocate"},
+                              {"name", "a name long enough to allocate"},
+                              {"tags", {"a tag long enough to allocate"}}};
+
+    // fields that don't use a polymorphic allocator are converted as usual
+    std::pmr::monotonic_buffer_resource arena;
+    test_types::MixedPmrStruct s;
+    reflecxx::fromJson(j, s, &arena);
+    EXPECT_EQ(s.label, "a label long enough to allocate");
+    EXPECT_EQ(s.name.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.tags.get_allocator().resource(), &arena);
+    EXPECT_EQ(s.tags[0], "a tag long enough to allocate");
+    EXPECT_EQ(j.get<test_types::MixedPmrStruct>(), s);
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/fixtures.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/json_writer.hpp>
+
+TEST(json_writer, keys) {
+    // keys are escaped, quoted and separated at compile time
+    static_assert(reflecxx::detail::JsonKey<test_types::BasicStruct, 0>::value == R"({"b":)");
+    static_assert(reflecxx::detail::JsonKey<test_types::BasicStruct, 2>::value == R"(,"d":)");
+}
+
+TEST(json_writer, escape) {
+    EXPECT_EQ(reflecxx::toJsonString(std::string{"a\"b\\c\nd\x01"}), R"("a\"b\\c\nd\u0001")");
+    static_assert(reflecxx::detail::jsonEscapedSize("a\"\x1f") == 1 + 2 + 6);
+}
+
+TEST(json_writer, values) {
+    EXPECT_EQ(reflecxx::toJsonString(true), "true");
+    EXPECT_EQ(reflecxx::toJsonString(-17), "-17");
+    EXPECT_EQ(reflecxx::toJsonString(0.1), "0.1");
+    EXPECT_EQ(reflecxx::toJsonString(std::numeric_limits<double>::infinity()), "null");
+    EXPECT_EQ(reflecxx::toJsonString(std::optional<int>{}), "null");
+    EXPECT_EQ(reflecxx::toJsonString(std::vector<int>{1, 2, 3}), "[1,2,3]");
+    EXPECT_EQ(reflecxx::toJsonString(std::vector<int>{}), "[]");
+    // char arrays are arrays, keeping bytes after a NUL
+    const char chars[4] = {'a', 'b', 0, 'c'};
+    EXPECT_EQ(reflecxx::toJsonString(chars), "[97,98,0,99]");
+
+    // reflected enums are written by name
+    EXPECT_EQ(reflecxx::toJsonString(test_types::Scoped::Second), R"("Second")");
+    EXPECT_EQ(reflecxx::toJsonString(static_cast<test_types::Scoped>(7)), "7");
+}
+
+TEST(json_writer, structs) {
+    EXPECT_EQ(reflecxx::toJsonString(test_types::buildNestingStruct()),
+              R"({"i":9,"d":-2.2,"bs":{"b":true,"i":1,"d":2.5},)"
+              R"("basicsArr":[{"b":true,"i":1,"d":2.5},{"b":false,"i":-5,"d":3.4},{"b":true,"i":1,"d":2.5}],)"
+              R"("basicsStdarr":[{"b":false,"i":-5,"d":3.4},{"b":false,"i":-5,"d":3.4}]})");
+
+    test_types::PackedStruct ps{-3, test_types::Scoped::Third, {1.5f, -2.5f}, {4, 5}};
+    EXPECT_EQ(reflecxx::toJsonString(ps), R"({"i":-3,"e":"Third","fArr":[1.5,-2.5],"sStdarr":[4,5]})");
+
+    // fields of base classes are included
+    test_types::SecondLevelChildClass sc{};
+    EXPECT_EQ(reflecxx::toJsonString(sc),
+              R"({"someField":0,"publicField":0,"b":false,"i":0,"d":0,"charField":0})");
+}
+
+TEST(json_writer, buffer) {
+    // write into a caller provided buffer
+    std::array<char, 64> buffer{};
+    test_types::BasicStruct bs{true, 1, 2.5};
+    const auto end = reflecxx::writeJson(bs, buffer.data());
+
+    EXPECT_EQ(std::string_view(buffer.data(), end - buffer.data()), R"({"b":true,"i":1,"d":2.5})");
+}
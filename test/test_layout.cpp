@@ -0,0 +1,115 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/layout.hpp>
+
+TEST(layout, fields) {
+    const auto& fields = reflecxx::layout<test_types::BasicStruct>();
+    ASSERT_EQ(fields.size(), 3u);
+    EXPECT_EQ(fields[0].name, "b");
+    EXPECT_EQ(fields[0].offset, offsetof(test_types::BasicStruct, b));
+    EXPECT_EQ(fields[0].size, sizeof(bool));
+    EXPECT_EQ(fields[0].kind, reflecxx::FieldKind::Arithmetic);
+    EXPECT_EQ(fields[2].name, "d");
+    EXPECT_EQ(fields[2].offset, offsetof(test_types::BasicStruct, d));
+    EXPECT_EQ(fields[2].alignment, alignof(double));
+
+    const auto& nesting = reflecxx::layout<test_types::NestingStruct>();
+    EXPECT_EQ(nesting[2].kind, reflecxx::FieldKind::Reflected);
+    EXPECT_EQ(nesting[3].kind, reflecxx::FieldKind::Array);
+    EXPECT_EQ(nesting[3].offset, offsetof(test_types::NestingStruct, basicsArr));
+    EXPECT_EQ(nesting[3].size, 3 * sizeof(test_types::BasicStruct));
+    EXPECT_EQ(nesting[4].kind, reflecxx::FieldKind::Array);
+
+    EXPECT_EQ(reflecxx::layout<test_types::PackedStruct>()[1].kind, reflecxx::FieldKind::Enum);
+    EXPECT_EQ(reflecxx::layout<test_types::PmrStruct>()[1].kind, reflecxx::FieldKind::Class);
+}
+
+TEST(layout, hotFields) {
+    // REFLECXX_HOT only marks the fields for the generator's layout report
+    const auto& fields = reflecxx::layout<test_types::HotColdStruct>();
+    ASSERT_EQ(fields.size(), 5u);
+    EXPECT_EQ(fields[3].name, "count");
+    EXPECT_EQ(fields[3].offset, offsetof(test_types::HotColdStruct, count));
+    EXPECT_EQ(fields[4].name, "ready");
+    EXPECT_EQ(fields[4].offset, offsetof(test_types::HotColdStruct, ready));
+}
+
+TEST(layout, compileTime) {
+    // no T needs to be created, not even one that can't be default constructed
+    static_assert(!std::is_default_constructible_v<test_types::ConstructedClass>);
+    constexpr const auto& fields = reflecxx::layout<test_types::ConstructedClass>();
+    static_assert(fields[0].offset == offsetof(test_types::ConstructedClass, id));
+    static_assert(fields[1].offset == offsetof(test_types::ConstructedClass, value));
+}
+
+TEST(layout, inheritedOffsets) {
+    // bases of a standard layout class start at its beginning
+    static_assert(std::is_standard_layout_v<test_types::FieldlessChildClass>);
+    const auto& fieldless = reflecxx::layout<test_types::FieldlessChildClass>();
+    ASSERT_EQ(fieldless.size(), 3u);
+    EXPECT_EQ(fieldless[1].name, "i");
+    EXPECT_EQ(fieldless[1].offset, offsetof(test_types::BasicClass, i));
+    EXPECT_EQ(fieldless[2].offset, offsetof(test_types::BasicClass, d));
+
+    // otherwise only the offsets of the class's own fields are known
+    test_types::SecondLevelChildClass s{};
+    const auto* base = reinterpret_cast<const unsigned char*>(&s);
+    const auto& fields = reflecxx::layout<test_types::SecondLevelChildClass>();
+    ASSERT_EQ(fields.size(), 6u);
+    EXPECT_EQ(fields[0].name, "someField");
+    EXPECT_EQ(fields[0].offset, static_cast<size_t>(reinterpret_cast<const unsigned char*>(&s.someField) - base));
+    for (size_t i = 1; i < fields.size(); ++i) {
+        EXPECT_FALSE(fields[i].offset.has_value()) << fields[i].name;
+    }
+    EXPECT_EQ(fields[5].name, "charField");
+    EXPECT_EQ(fields[5].size, sizeof(char));
+
+    test_types::PolymorphicClass p{};
+    EXPECT_EQ(reflecxx::layout<test_types::PolymorphicClass>()[0].offset,
+              static_cast<size_t>(reinterpret_cast<const unsigned char*>(&p.id) - reinterpret_cast<const unsigned char*>(&p)));
+}
+
+TEST(layout, paddingBytes) {
+    // bool, then padding up to the alignment of the int
+    static_assert(reflecxx::paddingBytes<test_types::BasicStruct>() ==
+                  sizeof(test_types::BasicStruct) - sizeof(bool) - sizeof(int) - sizeof(double));
+    static_assert(reflecxx::paddingBytes<test_types::PackedStruct>() == 0);
+    static_assert(reflecxx::paddingBytes<test_types::KeyStruct>() == 0);
+
+    // includes the padding of every nested BasicStruct
+    constexpr size_t basicPadding = reflecxx::paddingBytes<test_types::BasicStruct>();
+    static_assert(reflecxx::paddingBytes<test_types::NestingStruct>() ==
+                  sizeof(test_types::NestingStruct) - sizeof(int) - sizeof(double) - 6 * sizeof(test_types::BasicStruct) +
+                      6 * basicPadding);
+    static_assert(reflecxx::unreflectedBytes<test_types::NestingStruct>() == 0);
+}
+
+TEST(layout, unreflectedBytes) {
+    // the private and protected fields aren't visitable, nor is the padding between them
+    static_assert(reflecxx::unreflectedBytes<test_types::ChildClass>() == 2 * sizeof(int));
+    static_assert(reflecxx::paddingBytes<test_types::ChildClass>() ==
+                  sizeof(test_types::ChildClass) - sizeof(bool) - 4 * sizeof(int) - sizeof(double));
+    // unless the class reflects them, leaving only the padding
+    static_assert(reflecxx::unreflectedBytes<test_types::EncapsulatedClass>() == 0);
+    static_assert(reflecxx::paddingBytes<test_types::EncapsulatedClass>() ==
+                  sizeof(test_types::EncapsulatedClass) - sizeof(bool) - 2 * sizeof(int32_t) - sizeof(double));
+
+    // including those of visitable base classes
+    static_assert(reflecxx::unreflectedBytes<test_types::SecondLevelChildClass>() == 2 * sizeof(int));
+    // the fields of a base class that isn't visitable
+    static_assert(reflecxx::unreflectedBytes<test_types::ChildOfUnreflectedBaseClass>() == sizeof(int));
+    static_assert(reflecxx::paddingBytes<test_types::ChildOfUnreflectedBaseClass>() == 0);
+    // the vtable pointer
+    static_assert(reflecxx::unreflectedBytes<test_types::PolymorphicClass>() == sizeof(void*));
+    static_assert(reflecxx::paddingBytes<test_types::PolymorphicClass>() ==
+                  sizeof(test_types::PolymorphicClass) - sizeof(void*) - sizeof(int));
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/enums.hpp>
+#include <libtest_types/fixtures.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/msgpack.hpp>
+
+using reflecxx::MsgPackKeys;
+
+namespace {
+std::vector<std::byte> bytes(std::initializer_list<int> values) {
+    std::vector<std::byte> result;
+    for (const auto v : values) {
+        result.push_back(static_cast<std::byte>(v));
+    }
+    return result;
+}
+
+template <typename T>
+T roundTrip(const T& value) {
+    const auto data = reflecxx::toMsgPack(value);
+    return reflecxx::fromMsgPack<T>(data);
+}
+} // namespace
+
+TEST(msgpack, values) {
+    // integers use the smallest encoding that holds the value, whatever their type
+    EXPECT_EQ(reflecxx::toMsgPack(int64_t{5}), bytes({0x05}));
+    EXPECT_EQ(reflecxx::toMsgPack(-32), bytes({0xe0}));
+    EXPECT_EQ(reflecxx::toMsgPack(-33), bytes({0xd0, 0xdf}));
+    EXPECT_EQ(reflecxx::toMsgPack(uint16_t{200}), bytes({0xcc, 0xc8}));
+    EXPECT_EQ(reflecxx::toMsgPack(70000), bytes({0xce, 0x00, 0x01, 0x11, 0x70}));
+    EXPECT_EQ(reflecxx::toMsgPack(std::numeric_limits<int64_t>::min()),
+              bytes({0xd3, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+    EXPECT_EQ(reflecxx::toMsgPack(1.5f), bytes({0xca, 0x3f, 0xc0, 0x00, 0x00}));
+    EXPECT_EQ(reflecxx::toMsgPack(true), bytes({0xc3}));
+    EXPECT_EQ(reflecxx::toMsgPack(std::optional<int>{}), bytes({0xc0}));
+    EXPECT_EQ(reflecxx::toMsgPack(std::string{"abc"}), bytes({0xa3, 'a', 'b', 'c'}));
+    EXPECT_EQ(reflecxx::toMsgPack(std::vector<int>{1, -1}), bytes({0x92, 0x01, 0xff}));
+
+    EXPECT_EQ(roundTrip(std::numeric_limits<uint64_t>::max()), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(roundTrip(-1234567.25), -1234567.25);
+    EXPECT_EQ(roundTrip(std::string(300, 'x')), std::string(300, 'x'));
+    EXPECT_EQ(roundTrip(std::optional<int>{-7}), -7);
+    EXPECT_EQ(roundTrip(std::vector<std::string>(20, "s")), std::vector<std::string>(20, "s"));
+
+    // char arrays are arrays, keeping bytes after a NUL
+    const char chars[4] = {'a', 'b', 0, 'c'};
+    EXPECT_EQ(reflecxx::toMsgPack(chars), bytes({0x94, 'a', 'b', 0x00, 'c'}));
+    char charsRead[4]{};
+    reflecxx::readMsgPack(reflecxx::toMsgPack(chars), charsRead);
+    EXPECT_EQ(std::string(charsRead, 4), std::string(chars, 4));
+
+    // integers can be read into any type that holds them
+    const auto small = bytes({0xcd, 0x01, 0x00});
+    EXPECT_EQ(reflecxx::fromMsgPack<int64_t>(small), 256);
+    EXPECT_EQ(reflecxx::fromMsgPack<double>(small), 256.0);
+}
+
+TEST(msgpack, structs) {
+    const test_types::BasicStruct bs{true, 1, 2.5};
+    const auto data = reflecxx::toMsgPack(bs);
+    // a map of 3 entries, keyed by the field names
+    EXPECT_EQ(std::vector<std::byte>(data.begin(), data.begin() + 7), bytes({0x83, 0xa1, 'b', 0xc3, 0xa1, 'i', 0x01}));
+
+    const auto ns = test_types::buildNestingStruct();
+    EXPECT_EQ(roundTrip(ns), ns);
+
+    const test_types::PackedStruct ps{-3, test_types::Scoped::Third, {1.5f, -2.5f}, {4, 5}};
+    EXPECT_EQ(roundTrip(ps), ps);
+
+    // fields of base classes are included
+    test_types::SecondLevelChildClass sc;
+    sc.b = true;
+    sc.i = 3;
+    sc.d = 4.5;
+    sc.publicField = 2;
+    sc.charField = 'A';
+    sc.someField = 1.5;
+    const auto scData = reflecxx::toMsgPack(sc);
+    const auto scRead = reflecxx::fromMsgPack<test_types::SecondLevelChildClass>(scData);
+    EXPECT_EQ(scRead.i, 3);
+    EXPECT_EQ(scRead.publicField, 2);
+    EXPECT_EQ(scRead.charField, 'A');
+    EXPECT_EQ(scRead.someField, 1.5);
+
+    // as are the private fields of classes that reflect them
+    const test_types::EncapsulatedClass ec{7, -1.5, 9};
+    EXPECT_EQ(roundTrip(ec), ec);
+    EXPECT_EQ(reflecxx::fromMsgPack<test_types::EncapsulatedClass>(reflecxx::toMsgPack<MsgPackKeys::Indices>(ec)), ec);
+
+    // a field shadowing one of its base class
+    test_types::ShadowingClass shc{};
+    shc.i = 1;
+    shc.BasicClass::i = 2;
+    const auto shcRead = roundTrip(shc);
+    EXPECT_EQ(shcRead.i, 1);
+    EXPECT_EQ(shcRead.BasicClass::i, 2);
+}
+
+TEST(msgpack, indices) {
+    const test_types::BasicStruct bs{true, 1, 2.5};
+    const auto data = reflecxx::toMsgPack<MsgPackKeys::Indices>(bs);
+    EXPECT_EQ(std::vector<std::byte>(data.begin(), data.begin() + 5), bytes({0x83, 0x00, 0xc3, 0x01, 0x01}));
+    EXPECT_EQ(reflecxx::fromMsgPack<test_types::BasicStruct>(data), bs);
+
+    const auto ns = test_types::buildNestingStruct();
+    const auto indexed = reflecxx::toMsgPack<MsgPackKeys::Indices>(ns);
+    EXPECT_LT(indexed.size(), reflecxx::toMsgPack(ns).size());
+    EXPECT_EQ(reflecxx::fromMsgPack<test_types::NestingStruct>(indexed), ns);
+}
+
+TEST(msgpack, enumsAndFlags) {
+    EXPECT_EQ(reflecxx::toMsgPack(test_types::Scoped::Second), bytes({0xa6, 'S', 'e', 'c', 'o', 'n', 'd'}));
+    EXPECT_EQ(reflecxx::toMsgPack<MsgPackKeys::Indices>(test_types::Scoped::Second), bytes({0x01}));
+    // values without an enumerator are written as numbers
+    EXPECT_EQ(reflecxx::toMsgPack(static_cast<test_types::Scoped>(7)), bytes({0x07}));
+
+    const test_types::FlagsStruct fs{7, {test_types::Permission::Read, test_types::Permission::Execute}};
+    const auto named = reflecxx::toMsgPack(fs);
+    const auto numbered = reflecxx::toMsgPack<MsgPackKeys::Indices>(fs);
+    EXPECT_EQ(numbered, bytes({0x82, 0x00, 0x07, 0x01, 0x05}));
+    EXPECT_EQ(reflecxx::fromMsgPack<test_types::FlagsStruct>(named), fs);
+    EXPECT_EQ(reflecxx::fromMsgPack<test_types::FlagsStruct>(numbered), fs);
+}
+
+TEST(msgpack, schemaEvolution) {
+    // BasicStruct and PackedStruct only share the field i
+    const auto data = reflecxx::toMsgPack(test_types::BasicStruct{true, 4, 2.5});
+    test_types::PackedStruct ps{-3, test_types::Scoped::Third, {1.5f, -2.5f}, {4, 5}};
+    reflecxx::readMsgPack(data, ps);
+    EXPECT_EQ(ps, (test_types::PackedStruct{4, test_types::Scoped::Third, {1.5f, -2.5f}, {4, 5}}));
+
+    // unknown keys of every type are skipped: nested containers, bin, ext, and out of range indices
+    const auto unknown = bytes({0x86,                                       // map of 6
+                                0xa1, 'x', 0x92, 0x81, 0xa1, 'y', 0xc0, 0xc2, // "x": [{"y": nil}, false]
+                                0xa1, 'i', 0x2a,                            // "i": 42
+                                0xa1, 'z', 0xc4, 0x02, 0x01, 0x02,          // "z": bin of 2 bytes
+                                0x07, 0xd6, 0x01, 0x00, 0x00, 0x00, 0x00,   // 7: fixext 4
+                                0xff, 0xcb, 0, 0, 0, 0, 0, 0, 0, 0,         // -1: double
+                                0x02, 0xcb, 0x40, 0x04, 0, 0, 0, 0, 0, 0}); // 2 (d): 2.5
+    const auto bs = reflecxx::fromMsgPack<test_types::BasicStruct>(unknown);
+    EXPECT_EQ(bs, (test_types::BasicStruct{false, 42, 2.5}));
+}
+
+TEST(msgpack, errors) {
+    EXPECT_THROW(reflecxx::fromMsgPack<int>(bytes({})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<int>(bytes({0x01, 0x02})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<int>(bytes({0xcd, 0x01})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<int>(bytes({0xcb, 0, 0, 0, 0, 0, 0, 0, 0})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<uint8_t>(bytes({0xff})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<int8_t>(bytes({0xcc, 0x80})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<std::string>(bytes({0xa3, 'a'})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<test_types::Scoped>(bytes({0xa1, 'x'})), std::runtime_error);
+    EXPECT_THROW((reflecxx::fromMsgPack<std::array<int, 2>>(bytes({0x91, 0x01}))), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<test_types::BasicStruct>(bytes({0x81, 0xc0, 0x01})), std::runtime_error);
+    EXPECT_THROW(reflecxx::fromMsgPack<test_types::BasicStruct>(bytes({0x81, 0xa1, 'x', 0xc1})), std::runtime_error);
+    try {
+        reflecxx::fromMsgPack<test_types::BasicStruct>(bytes({0x81, 0xa1, 'i', 0xc3}));
+        FAIL() << "Expected type mismatch";
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(std::string{e.what()}, "MessagePack parse error at offset 3: expected an integer");
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/fixtures.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/patch.hpp>
+
+TEST(patch, diffEqual) {
+    const auto n = test_types::buildNestingStruct();
+    EXPECT_TRUE(reflecxx::diff(n, n).empty());
+
+    const test_types::KeyStruct k{7, test_types::Scoped::Second, {1, 2}};
+    EXPECT_TRUE(reflecxx::diff(k, k).empty());
+}
+
+TEST(patch, diffPaths) {
+    const auto from = test_types::buildNestingStruct();
+    auto to = from;
+    to.d = 1.5;
+    to.basicsArr[1].i = 42;
+    to.basicsStdarr[0].b = true;
+
+    const auto patch = reflecxx::diff(from, to);
+    ASSERT_EQ(patch.size(), 3u);
+    EXPECT_EQ(patch.entries[0].path, (std::vector<uint32_t>{1}));
+    EXPECT_EQ(patch.entries[1].path, (std::vector<uint32_t>{3, 1, 1}));
+    EXPECT_EQ(patch.entries[2].path, (std::vector<uint32_t>{4, 0, 0}));
+
+    // base class fields are indexed as for reflecxx::get
+    test_types::SecondLevelChildClass s1{};
+    auto s2 = s1;
+    s2.i = 3;
+    s2.charField = 'x';
+    const auto classPatch = reflecxx::diff(s1, s2);
+    ASSERT_EQ(classPatch.size(), 2u);
+    EXPECT_EQ(classPatch.entries[0].path, (std::vector<uint32_t>{3}));
+    EXPECT_EQ(classPatch.entries[1].path, (std::vector<uint32_t>{5}));
+}
+
+TEST(patch, apply) {
+    const auto from = test_types::buildNestingStruct();
+    auto to = from;
+    to.i = -1;
+    to.bs.d = 0.25;
+    to.basicsArr[2] = {false, 8, 9.5};
+    to.basicsStdarr[1].i = 6;
+
+    auto patched = from;
+    reflecxx::apply(patched, reflecxx::diff(from, to));
+    EXPECT_EQ(patched, to);
+
+    test_types::PackedStruct p1{1, test_types::Scoped::First, {1.f, 2.f}, {3, 4}};
+    auto p2 = p1;
+    p2.e = test_types::Scoped::Third;
+    p2.sStdarr[1] = -4;
+    auto patchedPacked = p1;
+    reflecxx::apply(patchedPacked, reflecxx::diff(p1, p2));
+    EXPECT_EQ(patchedPacked, p2);
+
+    test_types::SecondLevelChildClass s1{};
+    auto s2 = s1;
+    s2.someField = 1.5;
+    s2.d = 2.5;
+    reflecxx::apply(s1, reflecxx::diff(s1, s2));
+    EXPECT_TRUE(reflecxx::equalTo(s1, s2));
+}
+
+TEST(patch, applyOnlyTouchesChangedFields) {
+    const auto from = test_types::buildNestingStruct();
+    auto to = from;
+    to.basicsArr[0].i = 11;
+    const auto patch = reflecxx::diff(from, to);
+
+    // a patch can be replayed onto an object other than the one it was taken from
+    test_types::NestingStruct other{};
+    reflecxx::apply(other, patch);
+    test_types::NestingStruct expected{};
+    expected.basicsArr[0].i = 11;
+    EXPECT_EQ(other, expected);
+}
+
+TEST(patch, binary) {
+    const auto from = test_types::buildNestingStruct();
+    auto to = from;
+    to.d = 1.5;
+    to.basicsArr[1].i = 42;
+    const auto patch = reflecxx::diff(from, to);
+
+    const auto bytes = reflecxx::patchToBinary(patch);
+    const auto roundTrip = reflecxx::patchFromBinary<test_types::NestingStruct>(bytes);
+    EXPECT_EQ(roundTrip.entries, patch.entries);
+
+    auto patched = from;
+    reflecxx::apply(patched, roundTrip);
+    EXPECT_EQ(patched, to);
+
+    const auto truncated = reflecxx::span<const std::byte>{bytes}.subspan(0, bytes.size() - 1);
+    EXPECT_THROW(reflecxx::patchFromBinary<test_types::NestingStruct>(truncated), std::runtime_error);
+}
+
+TEST(patch, malformed) {
+    test_types::NestingStruct n{};
+    reflecxx::Patch<test_types::NestingStruct> patch;
+    // field index out of range
+    patch.entries = {{{5}, {}}};
+    EXPECT_THROW(reflecxx::apply(n, patch), std::runtime_error);
+    // array index out of range
+    patch.entries = {{{3, 3, 0}, {}}};
+    EXPECT_THROW(reflecxx::apply(n, patch), std::runtime_error);
+    // path stops at a nested struct
+    patch.entries = {{{2}, {}}};
+    EXPECT_THROW(reflecxx::apply(n, patch), std::runtime_error);
+    // path continues past a value
+    patch.entries = {{{0, 0}, {}}};
+    EXPECT_THROW(reflecxx::apply(n, patch), std::runtime_error);
+    // value of the wrong size
+    patch.entries = {{{0}, "ab"}};
+    EXPECT_THROW(reflecxx::apply(n, patch), std::runtime_error);
+    // bool that's neither 0 nor 1
+    patch.entries = {{{2, 0}, std::string(1, '\x02')}};
+    EXPECT_THROW(reflecxx::apply(n, patch), std::runtime_error);
+    patch.entries = {{{2, 0}, std::string(1, '\x01')}};
+    reflecxx::apply(n, patch);
+    EXPECT_TRUE(n.bs.b);
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/soa_vector.hpp>
+
+TEST(soa_vector, columns) {
+    reflecxx::soa_vector<test_types::BasicStruct> soa{{true, 1, 1.5}, {false, 2, 2.5}, {true, 3, 3.5}};
+    ASSERT_EQ(soa.size(), 3u);
+
+    static_assert(std::is_same_v<decltype(soa.column<1>()), reflecxx::span<int>>);
+    const auto is = soa.column<1>();
+    EXPECT_EQ(std::accumulate(is.begin(), is.end(), 0), 6);
+    const auto ds = soa.column<2>();
+    EXPECT_EQ(ds[0], 1.5);
+    EXPECT_EQ(ds[2], 3.5);
+    // bools are stored as bools, not packed bits
+    EXPECT_EQ(soa.column<0>()[1], false);
+
+    const auto& constSoa = soa;
+    static_assert(std::is_same_v<decltype(constSoa.column<2>()), reflecxx::span<const double>>);
+}
+
+TEST(soa_vector, rows) {
+    reflecxx::soa_vector<test_types::BasicStruct> soa;
+    soa.push_back({true, 1, 1.5});
+    soa.emplace_back().get<1>() = 5;
+
+    EXPECT_EQ(soa[0].get<1>(), 1);
+    EXPECT_EQ(soa[1].get<0>(), false);
+    EXPECT_EQ(soa[1].get<1>(), 5);
+
+    // rows convert to and assign from T
+    test_types::BasicStruct bs = soa[0];
+    EXPECT_EQ(bs, (test_types::BasicStruct{true, 1, 1.5}));
+    soa[1] = test_types::BasicStruct{true, 7, 7.5};
+    EXPECT_EQ(static_cast<test_types::BasicStruct>(soa[1]), (test_types::BasicStruct{true, 7, 7.5}));
+
+    // assigning a row copies the values, rather than rebinding
+    soa[0] = soa[1];
+    EXPECT_EQ(soa[0].get<1>(), 7);
+    soa[1].get<1>() = 8;
+    EXPECT_EQ(soa[0].get<1>(), 7);
+
+    int sum = 0;
+    for (const auto row : soa) {
+        sum += row.get<1>();
+    }
+    EXPECT_EQ(sum, 15);
+
+    EXPECT_THROW(soa.at(2), std::out_of_range);
+}
+
+TEST(soa_vector, resize) {
+    reflecxx::soa_vector<test_types::PackedStruct> soa;
+    for (int i = 0; i < 100; ++i) {
+        soa.push_back({i, test_types::Scoped::Second, {1.0f * i, 2.0f * i}, {3, 4}});
+    }
+    ASSERT_EQ(soa.size(), 100u);
+    EXPECT_GE(soa.capacity(), 100u);
+    // values survive reallocation, including array fields
+    const test_types::PackedStruct last = soa[99];
+    EXPECT_EQ(last, (test_types::PackedStruct{99, test_types::Scoped::Second, {99.0f, 198.0f}, {3, 4}}));
+
+    // copies are deep
+    auto copy = soa;
+    copy[0].get<0>() = -1;
+    EXPECT_EQ(soa[0].get<0>(), 0);
+
+    // rows removed and then grown back are value initialized
+    soa.resize(50);
+    soa.resize(51);
+    EXPECT_EQ(static_cast<test_types::PackedStruct>(soa[50]), test_types::PackedStruct{});
+    soa.pop_back();
+    EXPECT_EQ(soa.size(), 50u);
+    soa.clear();
+    EXPECT_TRUE(soa.empty());
+}
+
+TEST(soa_vector, inherited) {
+    // fields of base classes get their own columns, in visitation order
+    reflecxx::soa_vector<test_types::SecondLevelChildClass> soa(2);
+    test_types::SecondLevelChildClass sc{};
+    sc.someField = 1.5;
+    sc.i = 3;
+    sc.charField = 'c';
+    soa[1] = sc;
+
+    EXPECT_EQ(soa.column<0>()[1], 1.5);
+    EXPECT_EQ(soa.column<3>()[1], 3);
+    EXPECT_EQ(soa.column<5>()[1], 'c');
+    EXPECT_EQ(static_cast<test_types::SecondLevelChildClass>(soa[1]).charField, 'c');
+}
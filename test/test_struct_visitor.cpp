@@ -118,6 +118,62 @@ TEST(struct_visitor, visitDerivedClassUnreflectedBase) {
     static_assert(reflecxx::fieldCount<test_types::ChildOfUnreflectedBaseClass>() == 1);
 }
 
+TEST(struct_visitor, visitPrivateFields) {
+    // non-public fields are only reflected for classes that declare REFLECXX_FRIEND, after the public ones
+    static_assert(reflecxx::fieldCount<test_types::EncapsulatedClass>() == 4);
+    static_assert(reflecxx::getName<0, test_types::EncapsulatedClass>() == "enabled");
+    static_assert(reflecxx::getName<1, test_types::EncapsulatedClass>() == "id");
+    static_assert(reflecxx::getName<3, test_types::EncapsulatedClass>() == "count");
+    static_assert(reflecxx::hasField<test_types::EncapsulatedClass>("scale"));
+    static_assert(!reflecxx::hasField<test_types::ChildClass>("privateField"));
+
+    test_types::EncapsulatedClass ec{3, 1.5, 7};
+    InstanceTypeCounterVisitor v{};
+    reflecxx::forEachField(ec, v);
+    EXPECT_EQ(v.otherTypes, 1);
+    EXPECT_EQ(v.ints, 2);
+    EXPECT_EQ(v.doubles, 1);
+
+    // they're accessed in place
+    reflecxx::get<1>(ec) = 4;
+    reflecxx::get<2>(ec) *= 2;
+    EXPECT_EQ(ec.getId(), 4);
+    EXPECT_EQ(ec.getScale(), 3.0);
+
+    // and compared
+    EXPECT_EQ(ec, (test_types::EncapsulatedClass{4, 3.0, 7}));
+    EXPECT_FALSE(ec == (test_types::EncapsulatedClass{4, 3.0, 8}));
+}
+
+TEST(struct_visitor, visitAccummulate) {
+    test_types::SecondLevelChildClass sc{};
+    sc.someField = 1.5;
+    sc.publicField = 2;
+    sc.charField = 'c';
+
+    // Results are accumulated in visitation order, with those of all base classes flattened in.
+    int order = 0;
+    const auto results = reflecxx::visitAccummulate(
+        sc, [&order](std::string_view name, const auto&) { return std::make_pair(order++, name); });
+    static_assert(std::tuple_size_v<std::remove_const_t<decltype(results)>> == 6);
+    EXPECT_EQ(std::get<0>(results), std::make_pair(0, std::string_view{"someField"}));
+    EXPECT_EQ(std::get<1>(results), std::make_pair(1, std::string_view{"publicField"}));
+    EXPECT_EQ(std::get<2>(results), std::make_pair(2, std::string_view{"b"}));
+    EXPECT_EQ(std::get<5>(results), std::make_pair(5, std::string_view{"charField"}));
+
+    // Results are held by value, even when the visitor returns references.
+    const auto values = reflecxx::visitAccummulate(sc, [](std::string_view, auto& member) -> auto& { return member; });
+    static_assert(std::is_same_v<std::remove_const_t<decltype(values)>,
+                                 std::tuple<double, int, bool, int, double, char>>);
+    EXPECT_EQ(std::get<0>(values), 1.5);
+    EXPECT_EQ(std::get<1>(values), 2);
+    EXPECT_EQ(std::get<5>(values), 'c');
+
+    constexpr auto names =
+        reflecxx::visitAccummulate<test_types::SecondLevelChildClass>([](std::string_view name, auto) { return name; });
+    static_assert(std::get<3>(names) == "i");
+}
+
 TEST(struct_visitor, getName) {
     // put static_asserts in a TEST simply for organization
     static_assert(reflecxx::getName<test_types::BasicStruct>() == "BasicStruct");
@@ -153,6 +209,106 @@ TEST(struct_visitor, get) {
     static_assert(std::is_const_v<std::remove_reference_t<decltype(dref2)>>);
 }
 
+TEST(struct_visitor, getInherited) {
+    // fields of base classes, including a second base class that doesn't sit at offset 0 in the derived object
+    static_assert(reflecxx::getName<0, test_types::SecondLevelChildClass>() == "someField");
+    static_assert(reflecxx::getName<2, test_types::SecondLevelChildClass>() == "b");
+    static_assert(reflecxx::getName<5, test_types::SecondLevelChildClass>() == "charField");
+    static_assert(std::is_same_v<reflecxx::typeAt<5, test_types::SecondLevelChildClass>, char>);
+
+    test_types::SecondLevelChildClass sc{};
+    reflecxx::get<1>(sc) = 3;
+    reflecxx::get<3>(sc) = 4;
+    reflecxx::get<5>(sc) = 'x';
+
+    EXPECT_EQ(sc.publicField, 3);
+    EXPECT_EQ(sc.i, 4);
+    EXPECT_EQ(sc.charField, 'x');
+
+    // indexed access agrees with visitation order
+    std::array<const void*, reflecxx::fieldCount<test_types::SecondLevelChildClass>()> visited{};
+    size_t count = 0;
+    auto record = [&visited, &count](std::string_view, const auto& member) { visited[count++] = &member; };
+    reflecxx::forEachField(sc, record);
+    count = 0;
+    auto check = [&visited, &count](std::string_view, const auto& member) { EXPECT_EQ(visited[count++], &member); };
+    reflecxx::applyForEach(check, sc);
+    EXPECT_EQ(count, visited.size());
+}
+
+TEST(struct_visitor, getByName) {
+    static_assert(reflecxx::fieldIndex<test_types::BasicStruct>("d") == 2);
+    static_assert(reflecxx::fieldIndex<test_types::SecondLevelChildClass>("charField") == 5);
+    static_assert(reflecxx::hasField<test_types::SecondLevelChildClass>("b"));
+    static_assert(!reflecxx::hasField<test_types::SecondLevelChildClass>("privateField"));
+    EXPECT_THROW(reflecxx::fieldIndex<test_types::BasicStruct>("x"), std::runtime_error);
+
+    // resolved at compile time
+    test_types::SecondLevelChildClass sc{};
+    reflecxx::get<reflecxx::fieldIndex<test_types::SecondLevelChildClass>("i")>(sc) = 4;
+    EXPECT_EQ(sc.i, 4);
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+    reflecxx::get<"charField">(sc) = 'x';
+    EXPECT_EQ(sc.charField, 'x');
+    static_assert(reflecxx::has_field_v<test_types::SecondLevelChildClass, "someField">);
+    static_assert(!reflecxx::has_field_v<test_types::SecondLevelChildClass, "protectedField">);
+#endif
+
+    // resolved at runtime
+    auto setInt = [](std::string_view name, auto& member) {
+        EXPECT_EQ(name, "publicField");
+        if constexpr (std::is_same_v<std::remove_reference_t<decltype(member)>, int>) {
+            member = 7;
+        }
+    };
+    EXPECT_TRUE(reflecxx::getByName(sc, "publicField", setInt));
+    EXPECT_EQ(sc.publicField, 7);
+    EXPECT_FALSE(reflecxx::getByName(sc, "publicFiel", setInt));
+    EXPECT_FALSE(reflecxx::getByName(sc, "", setInt));
+
+    const auto& csc = sc;
+    double value = 0;
+    EXPECT_TRUE(reflecxx::getByName(csc, "d", [&value](std::string_view, const auto& member) { value = member; }));
+    EXPECT_EQ(value, sc.d);
+}
+
+TEST(struct_visitor, getByNameShadowed) {
+    // the field of the derived class comes first, so it's the one found by name
+    static_assert(reflecxx::fieldCount<test_types::ShadowingClass>() == 4);
+    static_assert(reflecxx::fieldIndex<test_types::ShadowingClass>("i") == 0);
+    static_assert(reflecxx::fieldIndex<test_types::ShadowingClass>("d") == 3);
+
+    test_types::ShadowingClass sc{};
+    EXPECT_TRUE(reflecxx::getByName(sc, "i", [](std::string_view, auto& member) { member = 5; }));
+    EXPECT_EQ(sc.i, 5);
+    EXPECT_EQ(sc.BasicClass::i, 0);
+    EXPECT_TRUE(reflecxx::getByName(sc, "d", [](std::string_view, auto& member) { member = 1.5; }));
+    EXPECT_EQ(sc.d, 1.5);
+}
+
+TEST(struct_visitor, virtualBase) {
+    // the fields of a virtual base are reached by visiting through a cast, rather than through pointers to members
+    static_assert(reflecxx::fieldCount<test_types::VirtualChildClass>() == 4);
+    static_assert(reflecxx::getName<1, test_types::VirtualChildClass>() == "b");
+    static_assert(std::is_same_v<reflecxx::typeAt<3, test_types::VirtualChildClass>, double>);
+    static_assert(reflecxx::fieldIndex<test_types::VirtualChildClass>("i") == 2);
+
+    test_types::VirtualChildClass vc{};
+    reflecxx::get<0>(vc) = 1;
+    reflecxx::get<2>(vc) = 2;
+    EXPECT_EQ(vc.childField, 1);
+    EXPECT_EQ(vc.i, 2);
+    EXPECT_TRUE(reflecxx::getByName(vc, "d", [](std::string_view, auto& member) { member = 1.5; }));
+    EXPECT_EQ(vc.d, 1.5);
+
+    const auto copy = vc;
+    EXPECT_EQ(copy, vc);
+    vc.b = true;
+    EXPECT_FALSE(copy == vc);
+    EXPECT_TRUE(reflecxx::threeWay(copy, vc) < 0);
+}
+
 TEST(struct_visitor, equalTo) {
     test_types::BasicStruct bs1{/*b=*/true, /*i=*/1, /*d=*/1.5};
     test_types::BasicStruct bs2{/*b=*/true, /*i=*/1, /*d=*/1.5};
@@ -198,6 +354,72 @@ TEST(struct_visitor, greaterThanLessThan) {
     EXPECT_FALSE(reflecxx::greaterThan(bs4, bs1));
 }
 
+TEST(struct_visitor, compareStopsEarly) {
+    test_types::BasicStruct bs1{/*b=*/true, /*i=*/1, /*d=*/1.5};
+    test_types::BasicStruct bs2{/*b=*/false, /*i=*/1, /*d=*/1.5};
+
+    int calls = 0;
+    const auto countingEqual = [&calls](const auto& a, const auto& b) {
+        ++calls;
+        return a == b;
+    };
+    EXPECT_FALSE(reflecxx::compare(bs1, bs2, countingEqual));
+    // only the first field
+    EXPECT_EQ(calls, 1);
+
+    calls = 0;
+    EXPECT_TRUE(reflecxx::compare(bs1, bs1, countingEqual));
+    EXPECT_EQ(calls, 3);
+
+    // stops inside arrays too
+    test_types::NestingStruct ns1{1, 1.5, bs1, {bs1, bs1, bs1}, {bs1, bs1}};
+    test_types::NestingStruct ns2{1, 1.5, bs1, {bs2, bs1, bs1}, {bs1, bs1}};
+    calls = 0;
+    EXPECT_FALSE(reflecxx::compare(ns1, ns2, [&calls](const auto& a, const auto& b) {
+        ++calls;
+        if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(a)>>, test_types::BasicStruct>) {
+            return reflecxx::equalTo(a, b);
+        } else {
+            return a == b;
+        }
+    }));
+    // i, d, bs, the array size, then the first field of the first element
+    EXPECT_EQ(calls, 5);
+}
+
+TEST(struct_visitor, threeWay) {
+    test_types::BasicStruct bs1{/*b=*/true, /*i=*/1, /*d=*/1.5};
+    test_types::BasicStruct bs2{/*b=*/true, /*i=*/1, /*d=*/0.5};
+    test_types::BasicStruct bs3{/*b=*/true, /*i=*/2, /*d=*/0.5};
+    test_types::BasicStruct bs4{/*b=*/false, /*i=*/2, /*d=*/2.5};
+
+    EXPECT_TRUE(reflecxx::threeWay(bs1, bs1) == 0);
+    EXPECT_TRUE(reflecxx::threeWay(bs2, bs1) < 0);
+    EXPECT_TRUE(reflecxx::threeWay(bs1, bs2) > 0);
+    // lexicographic: the first differing field decides
+    EXPECT_TRUE(reflecxx::threeWay(bs3, bs1) > 0);
+    EXPECT_TRUE(reflecxx::threeWay(bs4, bs1) < 0);
+    static_assert(reflecxx::threeWay(test_types::BasicStruct{true, 1, 0.0}, test_types::BasicStruct{true, 1, 1.0}) < 0);
+
+    // nested types and arrays, element by element
+    test_types::NestingStruct ns1{1, 1.5, bs1, {bs1, bs1, bs1}, {bs1, bs1}};
+    test_types::NestingStruct ns2{1, 1.5, bs1, {bs1, bs1, bs1}, {bs1, bs2}};
+    test_types::NestingStruct ns3{1, 1.5, bs1, {bs1, bs4, bs3}, {bs1, bs1}};
+    EXPECT_TRUE(reflecxx::threeWay(ns1, ns1) == 0);
+    EXPECT_TRUE(reflecxx::threeWay(ns2, ns1) < 0);
+    EXPECT_TRUE(reflecxx::threeWay(ns3, ns1) < 0);
+    EXPECT_TRUE(reflecxx::threeWay(ns3, ns2) < 0);
+
+    // base class fields follow the derived class's own
+    test_types::SecondLevelChildClass sc1{};
+    auto sc2 = sc1;
+    sc2.charField = 'a';
+    sc1.i = 1;
+    EXPECT_TRUE(reflecxx::threeWay(sc1, sc2) > 0);
+    sc2.someField = 1.0;
+    EXPECT_TRUE(reflecxx::threeWay(sc1, sc2) < 0);
+}
+
 TEST(generation, type_traits) {
     struct MyType {};
 
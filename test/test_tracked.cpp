@@ -0,0 +1,104 @@
+// Copyright (c) 2021-2022 Jimmy O'Rourke
+// Licensed under and subject to the terms of the LICENSE file accompanying this distribution.
+// Official repository: https://github.com/jimmyorourke/reflecxx
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <libtest_types/classes.hpp>
+#include <libtest_types/structs.hpp>
+#include <reflecxx/tracked.hpp>
+
+TEST(tracked, dirtyBits) {
+    reflecxx::tracked<test_types::NestingStruct> t;
+    EXPECT_FALSE(t.anyDirty());
+
+    t.set<1>(2.5);
+    EXPECT_EQ(t.get<1>(), 2.5);
+    EXPECT_TRUE(t.isDirty(1));
+    EXPECT_EQ(t.dirtyFields().count(), 1u);
+
+    // C-style arrays are assigned element-wise
+    const test_types::BasicStruct arr[3] = {{true, 1, 1.0}, {false, 2, 2.0}, {true, 3, 3.0}};
+    t.set<3>(arr);
+    EXPECT_EQ(t.get<3>()[2].i, 3);
+
+    t.modify<2>().i = 7;
+    EXPECT_EQ(t.value().bs.i, 7);
+    EXPECT_TRUE(t.isDirty(2));
+    EXPECT_FALSE(t.isDirty(0));
+    EXPECT_FALSE(t.isDirty(4));
+
+    t.clearDirty();
+    EXPECT_FALSE(t.anyDirty());
+    t.markAllDirty();
+    EXPECT_EQ(t.dirtyFields().count(), reflecxx::fieldCount<test_types::NestingStruct>());
+
+    // base class fields are indexed as for reflecxx::get
+    reflecxx::tracked<test_types::SecondLevelChildClass> c;
+    c.set<3>(4);
+    EXPECT_EQ(c.value().i, 4);
+    EXPECT_TRUE(c.isDirty(3));
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+TEST(tracked, byName) {
+    reflecxx::tracked<test_types::BasicStruct> t;
+    t.set<"d">(1.5);
+    EXPECT_EQ(t.get<"d">(), 1.5);
+    EXPECT_TRUE(t.isDirty(reflecxx::fieldIndex<test_types::BasicStruct>("d")));
+}
+#endif
+
+TEST(tracked, dirtyJson) {
+    reflecxx::tracked<test_types::NestingStruct> t;
+    EXPECT_EQ(reflecxx::toDirtyJson(t), "{}");
+
+    t.set<1>(2.5);
+    t.modify<2>().i = 7;
+    EXPECT_EQ(reflecxx::toDirtyJson(t), R"({"d":2.5,"bs":{"b":false,"i":7,"d":0}})");
+    // serializing clears the dirty bits
+    EXPECT_FALSE(t.anyDirty());
+    EXPECT_EQ(reflecxx::toDirtyJson(t), "{}");
+
+    t.set<0>(3);
+    const auto update = reflecxx::toDirtyJson(t);
+    EXPECT_EQ(update, R"({"i":3})");
+
+    // the partial object updates only the fields it contains
+    test_types::NestingStruct replica{};
+    replica.d = -1.0;
+    reflecxx::readJsonFields(update, replica);
+    EXPECT_EQ(replica.i, 3);
+    EXPECT_EQ(replica.d, -1.0);
+}
+
+TEST(tracked, dirtyBinary) {
+    reflecxx::tracked<test_types::PackedStruct> t;
+    EXPECT_EQ(reflecxx::toDirtyBinary(t).size(), 1u);
+
+    t.set<1>(test_types::Scoped::Third);
+    t.modify<3>()[1] = 5;
+    const auto bytes = reflecxx::toDirtyBinary(t);
+    EXPECT_FALSE(t.anyDirty());
+    // mask, then the enum and the std::array
+    EXPECT_EQ(bytes.size(), 1u + sizeof(test_types::Scoped) + 2 * sizeof(int16_t));
+
+    test_types::PackedStruct replica{4, test_types::Scoped::First, {1.f, 2.f}, {0, 0}};
+    reflecxx::fromDirtyBinary(bytes, replica);
+    EXPECT_EQ(replica, (test_types::PackedStruct{4, test_types::Scoped::Third, {1.f, 2.f}, {0, 5}}));
+
+    const auto truncated = reflecxx::span<const std::byte>{bytes}.subspan(0, bytes.size() - 1);
+    EXPECT_THROW(reflecxx::fromDirtyBinary(truncated, replica), std::runtime_error);
+
+    // a full snapshot round trips the whole object
+    reflecxx::tracked<test_types::NestingStruct> n;
+    n.modify<4>()[1].d = 6.5;
+    n.set<0>(2);
+    n.markAllDirty();
+    test_types::NestingStruct nestingReplica{};
+    const auto snapshot = reflecxx::toDirtyBinary(n);
+    reflecxx::fromDirtyBinary(snapshot, nestingReplica);
+    EXPECT_EQ(nestingReplica, n.value());
+}